@@ -305,22 +305,20 @@ ginPostingListDecodeAllSegments(GinPostingList *segment, int len, int *ndecoded_
 	unsigned char *endptr;
 
 	/*
-	 * Guess an initial size of the array.
+	 * Size the output array upfront.  Each segment stores one item in its
+	 * header, which is more than one byte long, and every other item
+	 * consumes at least one byte of varbyte data, so 'len' is a safe upper
+	 * bound on the number of items.  Allocating that much up front lets us
+	 * decode without any enlargement checks in the per-item loop.
 	 */
-	nallocated = segment->nbytes * 2 + 1;
+	nallocated = len;
 	result = palloc(nallocated * sizeof(ItemPointerData));
 
 	ndecoded = 0;
 	while ((char *) segment < endseg)
 	{
-		/* enlarge output array if needed */
-		if (ndecoded >= nallocated)
-		{
-			nallocated *= 2;
-			result = repalloc(result, nallocated * sizeof(ItemPointerData));
-		}
-
 		/* copy the first item */
+		Assert(ndecoded < nallocated);
 		Assert(OffsetNumberIsValid(ItemPointerGetOffsetNumber(&segment->first)));
 		Assert(ndecoded == 0 || ginCompareItemPointers(&segment->first, &result[ndecoded - 1]) > 0);
 		result[ndecoded] = segment->first;
@@ -331,15 +329,9 @@ ginPostingListDecodeAllSegments(GinPostingList *segment, int len, int *ndecoded_
 		endptr = segment->bytes + segment->nbytes;
 		while (ptr < endptr)
 		{
-			/* enlarge output array if needed */
-			if (ndecoded >= nallocated)
-			{
-				nallocated *= 2;
-				result = repalloc(result, nallocated * sizeof(ItemPointerData));
-			}
-
 			val += decode_varbyte(&ptr);
 
+			Assert(ndecoded < nallocated);
 			uint64_to_itemptr(val, &result[ndecoded]);
 			ndecoded++;
 		}
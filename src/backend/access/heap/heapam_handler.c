@@ -82,6 +82,7 @@ heapam_index_fetch_begin(Relation rel)
 
 	hscan->xs_base.rel = rel;
 	hscan->xs_cbuf = InvalidBuffer;
+	hscan->xs_pbuf = InvalidBuffer;
 
 	return &hscan->xs_base;
 }
@@ -96,6 +97,11 @@ heapam_index_fetch_reset(IndexFetchTableData *scan)
 		ReleaseBuffer(hscan->xs_cbuf);
 		hscan->xs_cbuf = InvalidBuffer;
 	}
+	if (BufferIsValid(hscan->xs_pbuf))
+	{
+		ReleaseBuffer(hscan->xs_pbuf);
+		hscan->xs_pbuf = InvalidBuffer;
+	}
 }
 
 static void
@@ -124,18 +130,43 @@ heapam_index_fetch_tuple(struct IndexFetchTableData *scan,
 	/* We can skip the buffer-switching logic if we're in mid-HOT chain. */
 	if (!*call_again)
 	{
+		BlockNumber blkno = ItemPointerGetBlockNumber(tid);
+
 		/* Switch to correct buffer if we don't have it already */
-		Buffer		prev_buf = hscan->xs_cbuf;
+		if (!BufferIsValid(hscan->xs_cbuf) ||
+			BufferGetBlockNumber(hscan->xs_cbuf) != blkno)
+		{
+			/*
+			 * The TIDs produced by an ordered index scan commonly bounce
+			 * back and forth between a small number of heap pages, so before
+			 * giving up our pin, check whether the previously used buffer is
+			 * the one wanted.  If so we can just swap the two cached buffers
+			 * and skip the unpin/repin cycle (and its buffer-header atomics)
+			 * entirely.
+			 */
+			if (BufferIsValid(hscan->xs_pbuf) &&
+				BufferGetBlockNumber(hscan->xs_pbuf) == blkno)
+			{
+				Buffer		tmp_buf = hscan->xs_cbuf;
 
-		hscan->xs_cbuf = ReleaseAndReadBuffer(hscan->xs_cbuf,
-											  hscan->xs_base.rel,
-											  ItemPointerGetBlockNumber(tid));
+				hscan->xs_cbuf = hscan->xs_pbuf;
+				hscan->xs_pbuf = tmp_buf;
 
-		/*
-		 * Prune page, but only if we weren't already on this page
-		 */
-		if (prev_buf != hscan->xs_cbuf)
-			heap_page_prune_opt(hscan->xs_base.rel, hscan->xs_cbuf);
+				/* no pruning; we pruned when we first read the page */
+			}
+			else
+			{
+				if (BufferIsValid(hscan->xs_pbuf))
+					ReleaseBuffer(hscan->xs_pbuf);
+				hscan->xs_pbuf = hscan->xs_cbuf;
+				hscan->xs_cbuf = ReadBuffer(hscan->xs_base.rel, blkno);
+
+				/*
+				 * Prune page, but only if we weren't already on this page
+				 */
+				heap_page_prune_opt(hscan->xs_base.rel, hscan->xs_cbuf);
+			}
+		}
 	}
 
 	/* Obtain share-lock on the buffer so we can examine visibility */
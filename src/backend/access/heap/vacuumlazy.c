@@ -63,6 +63,7 @@
 #include "utils/lsyscache.h"
 #include "utils/memutils.h"
 #include "utils/pg_rusage.h"
+#include "utils/spccache.h"
 #include "utils/timestamp.h"
 
 
@@ -1563,6 +1564,7 @@ lazy_scan_prune(LVRelState *vacrel,
 				live_tuples,
 				recently_dead_tuples;
 	int			nnewlpdead;
+	bool		eager_freeze;
 	TransactionId NewRelfrozenXid;
 	MultiXactId NewRelminMxid;
 	OffsetNumber deadoffsets[MaxHeapTuplesPerPage];
@@ -1587,6 +1589,7 @@ retry:
 	lpdead_items = 0;
 	live_tuples = 0;
 	recently_dead_tuples = 0;
+	eager_freeze = false;
 
 	/*
 	 * Prune all HOT-update chains in this page.
@@ -1806,6 +1809,59 @@ retry:
 
 	vacrel->offnum = InvalidOffsetNumber;
 
+	/*
+	 * If we are already going to dirty the page and emit a freeze record for
+	 * some of its tuples, consider freezing all of them.  Freezing the
+	 * remaining tuples adds nothing to the I/O or WAL overhead we're about
+	 * to pay, and if it makes the page all-frozen then the visibility map
+	 * can say so, sparing a future aggressive vacuum from rewriting the page
+	 * long after it went cold.  Use OldestXmin as the XID cutoff here:
+	 * everything that precedes it is safe to freeze, FreezeLimit is merely
+	 * the point where freezing stops being optional.  (The MultiXactId
+	 * cutoff is unchanged, so a page with newer MultiXactIds simply remains
+	 * not-all-frozen.)
+	 */
+	if (tuples_frozen > 0 && prunestate->all_visible && !prunestate->all_frozen)
+	{
+		/* Redo the freeze determination with the more aggressive cutoff */
+		NewRelfrozenXid = vacrel->NewRelfrozenXid;
+		NewRelminMxid = vacrel->NewRelminMxid;
+		tuples_frozen = 0;
+		prunestate->all_frozen = true;
+		eager_freeze = true;
+
+		for (offnum = FirstOffsetNumber;
+			 offnum <= maxoff;
+			 offnum = OffsetNumberNext(offnum))
+		{
+			bool		tuple_totally_frozen;
+
+			vacrel->offnum = offnum;
+			itemid = PageGetItemId(page, offnum);
+
+			/* An all-visible page has no LP_DEAD items to worry about */
+			if (!ItemIdIsNormal(itemid))
+				continue;
+
+			tuple.t_data = (HeapTupleHeader) PageGetItem(page, itemid);
+
+			if (heap_prepare_freeze_tuple(tuple.t_data,
+										  vacrel->relfrozenxid,
+										  vacrel->relminmxid,
+										  vacrel->OldestXmin,
+										  vacrel->MultiXactCutoff,
+										  &frozen[tuples_frozen],
+										  &tuple_totally_frozen,
+										  &NewRelfrozenXid, &NewRelminMxid))
+				frozen[tuples_frozen++].offset = offnum;
+
+			if (!tuple_totally_frozen)
+				prunestate->all_frozen = false;
+		}
+
+		vacrel->offnum = InvalidOffsetNumber;
+	}
+
 	/*
 	 * We have now divided every item on the page into either an LP_DEAD item
 	 * that will need to be vacuumed in indexes later, or a LP_NORMAL tuple
@@ -1851,9 +1907,21 @@ retry:
 		/* Now WAL-log freezing if necessary */
 		if (RelationNeedsWAL(vacrel->rel))
 		{
+			TransactionId snapshotConflictHorizon;
 			XLogRecPtr	recptr;
 
-			recptr = log_heap_freeze(vacrel->rel, buf, vacrel->FreezeLimit,
+			/*
+			 * When we froze eagerly, XIDs newer than FreezeLimit may have
+			 * been frozen, so the recovery conflict horizon must cover the
+			 * newest XID on the page, which visibility_cutoff_xid tracks
+			 * for an all-visible page.
+			 */
+			if (eager_freeze)
+				snapshotConflictHorizon = prunestate->visibility_cutoff_xid;
+			else
+				snapshotConflictHorizon = vacrel->FreezeLimit;
+
+			recptr = log_heap_freeze(vacrel->rel, buf, snapshotConflictHorizon,
 									 frozen, tuples_frozen);
 			PageSetLSN(page, recptr);
 		}
@@ -2412,6 +2480,15 @@ lazy_vacuum_heap_rel(LVRelState *vacrel)
 	BlockNumber vacuumed_pages;
 	Buffer		vmbuffer = InvalidBuffer;
 	LVSavedErrInfo saved_err_info;
+#ifdef USE_PREFETCH
+	int			prefetch_index = 0;
+	int			npending = 0;
+	BlockNumber prefetch_blkno = InvalidBlockNumber;
+	int			prefetch_maximum;
+
+	prefetch_maximum =
+		get_tablespace_maintenance_io_concurrency(vacrel->rel->rd_rel->reltablespace);
+#endif
 
 	Assert(vacrel->do_index_vacuuming);
 	Assert(vacrel->do_index_cleanup);
@@ -2440,6 +2517,34 @@ lazy_vacuum_heap_rel(LVRelState *vacrel)
 
 		tblk = ItemPointerGetBlockNumber(&vacrel->dead_items->items[index]);
 		vacrel->blkno = tblk;
+
+#ifdef USE_PREFETCH
+
+		/*
+		 * The dead_items array identifies, in order, every block this pass
+		 * will visit, so we can hint the kernel about upcoming reads.  Keep
+		 * prefetch_maximum distinct blocks in flight ahead of the one we're
+		 * about to process.
+		 */
+		if (npending > 0)
+			npending--;			/* about to consume a prefetched block */
+		while (npending < prefetch_maximum &&
+			   prefetch_index < vacrel->dead_items->num_items)
+		{
+			BlockNumber pblk;
+
+			pblk = ItemPointerGetBlockNumber(&vacrel->dead_items->items[prefetch_index]);
+			prefetch_index++;
+			if (pblk == prefetch_blkno)
+				continue;		/* more dead items on the same block */
+			prefetch_blkno = pblk;
+			if (pblk == tblk)
+				continue;		/* going to read it right now anyway */
+			PrefetchBuffer(vacrel->rel, MAIN_FORKNUM, pblk);
+			npending++;
+		}
+#endif
+
 		buf = ReadBufferExtended(vacrel->rel, MAIN_FORKNUM, tblk, RBM_NORMAL,
 								 vacrel->bstrategy);
 		LockBuffer(buf, BUFFER_LOCK_EXCLUSIVE);
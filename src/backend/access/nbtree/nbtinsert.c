@@ -288,28 +288,37 @@ search:
  *
  * The fastpath optimization avoids most of the work of searching the tree
  * repeatedly when a single backend inserts successive new tuples on the
- * rightmost leaf page of an index.  A backend cache of the rightmost leaf
- * page is maintained within _bt_insertonpg(), and used here.  The cache is
- * invalidated here when an insert of a non-pivot tuple must take place on a
- * non-rightmost leaf page.
+ * same leaf page of an index.  A backend cache of the most recent insertion
+ * target leaf page is maintained within _bt_insertonpg(), and used here.
+ * The cache is invalidated here when the cached page cannot accept an insert
+ * of a non-pivot tuple.
  *
- * The optimization helps with indexes on an auto-incremented field.  It also
- * helps with indexes on datetime columns, as well as indexes with lots of
- * NULL values.  (NULLs usually get inserted in the rightmost page for single
- * column indexes, since they usually get treated as coming after everything
- * else in the key space.  Individual NULL tuples will generally be placed on
- * the rightmost leaf page due to the influence of the heap TID column.)
+ * The optimization helps with indexes on an auto-incremented field, where
+ * every insert goes to the rightmost leaf page.  It also helps with indexes
+ * on datetime columns, indexes with lots of NULL values, and, more
+ * generally, any insert stream with enough key-space locality for runs of
+ * successive inserts to land on the same leaf page.  (NULLs usually get
+ * inserted in the rightmost page for single column indexes, since they
+ * usually get treated as coming after everything else in the key space.
+ * Individual NULL tuples will generally be placed on the rightmost leaf
+ * page due to the influence of the heap TID column.)
+ *
+ * The cached page can only be used when the new key provably belongs there:
+ * it must be strictly greater than the first non-pivot tuple (so no earlier
+ * leaf page could hold it), and strictly less than the high key, unless the
+ * page is the rightmost page (so _bt_search could not have moved right past
+ * it).
  *
  * Note that we avoid applying the optimization when there is insufficient
- * space on the rightmost page to fit caller's new item.  This is necessary
+ * space on the cached page to fit caller's new item.  This is necessary
  * because we'll need to return a real descent stack when a page split is
  * expected (actually, caller can cope with a leaf page split that uses a NULL
  * stack, but that's very slow and so must be avoided).  Note also that the
  * fastpath optimization acquires the lock on the page conditionally as a way
  * of reducing extra contention when there are concurrent insertions into the
- * rightmost page (we give up if we'd have to wait for the lock).  We assume
- * that it isn't useful to apply the optimization when there is contention,
- * since each per-backend cache won't stay valid for long.
+ * same page (we give up if we'd have to wait for the lock).  We assume that
+ * it isn't useful to apply the optimization when there is contention, since
+ * each per-backend cache won't stay valid for long.
  */
 static BTStack
 _bt_search_insert(Relation rel, BTInsertState insertstate)
@@ -332,25 +341,30 @@ _bt_search_insert(Relation rel, BTInsertState insertstate)
 			opaque = BTPageGetOpaque(page);
 
 			/*
-			 * Check if the page is still the rightmost leaf page and has
-			 * enough free space to accommodate the new tuple.  Also check
-			 * that the insertion scan key is strictly greater than the first
-			 * non-pivot tuple on the page.  (Note that we expect itup_key's
-			 * scantid to be unset when our caller is a checkingunique
-			 * inserter.)
+			 * Check if the page is still a leaf page with enough free space
+			 * to accommodate the new tuple, and that the insertion scan key
+			 * is strictly greater than the first non-pivot tuple on the
+			 * page.  Unless the page is the rightmost page, also check that
+			 * the insertion scan key is strictly less than the page's high
+			 * key, since a tree descent could otherwise have moved right
+			 * past this page.  (Note that we expect itup_key's scantid to be
+			 * unset when our caller is a checkingunique inserter.)
 			 */
-			if (P_RIGHTMOST(opaque) &&
-				P_ISLEAF(opaque) &&
+			if (P_ISLEAF(opaque) &&
 				!P_IGNORE(opaque) &&
 				PageGetFreeSpace(page) > insertstate->itemsz &&
-				PageGetMaxOffsetNumber(page) >= P_HIKEY &&
-				_bt_compare(rel, insertstate->itup_key, page, P_HIKEY) > 0)
+				PageGetMaxOffsetNumber(page) >= P_FIRSTDATAKEY(opaque) &&
+				_bt_compare(rel, insertstate->itup_key, page,
+							P_FIRSTDATAKEY(opaque)) > 0 &&
+				(P_RIGHTMOST(opaque) ||
+				 _bt_compare(rel, insertstate->itup_key, page, P_HIKEY) < 0))
 			{
 				/*
 				 * Caller can use the fastpath optimization because cached
-				 * block is still rightmost leaf page, which can fit caller's
-				 * new tuple without splitting.  Keep block in local cache for
-				 * next insert, and have caller use NULL stack.
+				 * block is still the correct leaf page for the new key, and
+				 * can fit caller's new tuple without splitting.  Keep block
+				 * in local cache for next insert, and have caller use NULL
+				 * stack.
 				 *
 				 * Note that _bt_insert_parent() has an assertion that catches
 				 * leaf page splits that somehow follow from a fastpath insert
@@ -1113,7 +1127,6 @@ _bt_insertonpg(Relation rel,
 	BTPageOpaque opaque;
 	bool		isleaf,
 				isroot,
-				isrightmost,
 				isonly;
 	IndexTuple	oposting = NULL;
 	IndexTuple	origitup = NULL;
@@ -1123,7 +1136,6 @@ _bt_insertonpg(Relation rel,
 	opaque = BTPageGetOpaque(page);
 	isleaf = P_ISLEAF(opaque);
 	isroot = P_ISROOT(opaque);
-	isrightmost = P_RIGHTMOST(opaque);
 	isonly = P_LEFTMOST(opaque) && P_RIGHTMOST(opaque);
 
 	/* child buffer must be given iff inserting on an internal page */
@@ -1400,11 +1412,12 @@ _bt_insertonpg(Relation rel,
 			_bt_relbuf(rel, cbuf);
 
 		/*
-		 * Cache the block number if this is the rightmost leaf page.  Cache
-		 * may be used by a future inserter within _bt_search_insert().
+		 * Cache the block number if this is a leaf page.  Cache may be used
+		 * by a future inserter within _bt_search_insert(), which proves for
+		 * itself that the new key still belongs on the cached page.
 		 */
 		blockcache = InvalidBlockNumber;
-		if (isrightmost && isleaf && !isroot)
+		if (isleaf && !isroot)
 			blockcache = BufferGetBlockNumber(buf);
 
 		/* Release buffer for insertion target block */
@@ -19,12 +19,15 @@
 #include "access/relscan.h"
 #include "miscadmin.h"
 #include "pgstat.h"
+#include "storage/bufmgr.h"
 #include "storage/predicate.h"
 #include "utils/lsyscache.h"
 #include "utils/rel.h"
+#include "utils/spccache.h"
 
 
 static void _bt_drop_lock_and_maybe_pin(IndexScanDesc scan, BTScanPos sp);
+static void _bt_prefetch_heappages(IndexScanDesc scan, ScanDirection dir);
 static OffsetNumber _bt_binsrch(Relation rel, BTScanInsert key, Buffer buf);
 static int	_bt_binsrch_posting(BTScanInsert key, Page page,
 								OffsetNumber offnum);
@@ -70,6 +73,74 @@ _bt_drop_lock_and_maybe_pin(IndexScanDesc scan, BTScanPos sp)
 	}
 }
 
+/*
+ *	_bt_prefetch_heappages() -- Issue readahead for the heap pages that the
+ *		items just loaded into so->currPos are going to visit.
+ *
+ * Bitmap heap scans already prefetch upcoming heap pages, but an ordered
+ * scan used to fault them in strictly one at a time.  Once a leaf page's
+ * matching items have been collected and the leaf lock dropped, we know
+ * exactly which heap blocks will be fetched next, so hint them to the
+ * kernel, up to the heap tablespace's effective_io_concurrency.
+ *
+ * This is a no-op for index-only scans, which mostly don't visit the heap,
+ * and for bitmap scans, which have no heapRelation here and do their own
+ * prefetching.
+ */
+static void
+_bt_prefetch_heappages(IndexScanDesc scan, ScanDirection dir)
+{
+#ifdef USE_PREFETCH
+	BTScanOpaque so = (BTScanOpaque) scan->opaque;
+	BlockNumber lastblkno = InvalidBlockNumber;
+	int			prefetch_maximum;
+	int			nprefetched = 0;
+	int			i;
+
+	if (scan->heapRelation == NULL || scan->xs_want_itup)
+		return;
+
+	prefetch_maximum =
+		get_tablespace_io_concurrency(scan->heapRelation->rd_rel->reltablespace);
+	if (prefetch_maximum <= 0)
+		return;
+
+	/*
+	 * Walk the loaded items in scan order, skipping runs of identical
+	 * blocks; correlated indexes produce long such runs and need very few
+	 * actual prefetch calls.
+	 */
+	if (ScanDirectionIsForward(dir))
+	{
+		for (i = so->currPos.firstItem; i <= so->currPos.lastItem; i++)
+		{
+			BlockNumber blkno = ItemPointerGetBlockNumber(&so->currPos.items[i].heapTid);
+
+			if (blkno == lastblkno)
+				continue;
+			PrefetchBuffer(scan->heapRelation, MAIN_FORKNUM, blkno);
+			lastblkno = blkno;
+			if (++nprefetched >= prefetch_maximum)
+				break;
+		}
+	}
+	else
+	{
+		for (i = so->currPos.lastItem; i >= so->currPos.firstItem; i--)
+		{
+			BlockNumber blkno = ItemPointerGetBlockNumber(&so->currPos.items[i].heapTid);
+
+			if (blkno == lastblkno)
+				continue;
+			PrefetchBuffer(scan->heapRelation, MAIN_FORKNUM, blkno);
+			lastblkno = blkno;
+			if (++nprefetched >= prefetch_maximum)
+				break;
+		}
+	}
+#endif							/* USE_PREFETCH */
+}
+
 /*
  *	_bt_search() -- Search the tree for a particular scankey,
  *		or more precisely for the first leaf page it could be on.
@@ -389,6 +460,22 @@ _bt_binsrch(Relation rel,
 
 		/* We have low <= mid < high, so mid points at a real slot */
 
+		/*
+		 * Hide some memory latency by prefetching the tuples at the two
+		 * possible next midpoints while this iteration's comparison is
+		 * still loading its own tuple.  One of the two is wasted work, but
+		 * on a page that isn't cache-resident the other saves a stall.
+		 * Either offset can run off the end of the line pointer array when
+		 * its half-interval is about to become empty; that only produces a
+		 * useless prefetch address, which the hardware quietly ignores.
+		 */
+		pg_prefetch_mem(PageGetItem(page,
+									PageGetItemId(page,
+												  low + ((mid - low) / 2))));
+		pg_prefetch_mem(PageGetItem(page,
+									PageGetItemId(page,
+												  mid + 1 + ((high - mid - 1) / 2))));
+
 		result = _bt_compare(rel, key, page, mid);
 
 		if (result >= cmpval)
@@ -1436,6 +1523,9 @@ _bt_first(IndexScanDesc scan, ScanDirection dir)
 	{
 		/* Drop the lock, and maybe the pin, on the current page */
 		_bt_drop_lock_and_maybe_pin(scan, &so->currPos);
+
+		/* Hint the kernel about the heap pages we're about to visit */
+		_bt_prefetch_heappages(scan, dir);
 	}
 
 readcomplete:
@@ -1963,6 +2053,9 @@ _bt_steppage(IndexScanDesc scan, ScanDirection dir)
 	/* Drop the lock, and maybe the pin, on the current page */
 	_bt_drop_lock_and_maybe_pin(scan, &so->currPos);
 
+	/* Hint the kernel about the heap pages we're about to visit */
+	_bt_prefetch_heappages(scan, dir);
+
 	return true;
 }
 
@@ -2167,6 +2260,9 @@ _bt_parallel_readpage(IndexScanDesc scan, BlockNumber blkno, ScanDirection dir)
 	/* Drop the lock, and maybe the pin, on the current page */
 	_bt_drop_lock_and_maybe_pin(scan, &so->currPos);
 
+	/* Hint the kernel about the heap pages we're about to visit */
+	_bt_prefetch_heappages(scan, dir);
+
 	return true;
 }
 
@@ -2462,6 +2558,9 @@ _bt_endpoint(IndexScanDesc scan, ScanDirection dir)
 	{
 		/* Drop the lock, and maybe the pin, on the current page */
 		_bt_drop_lock_and_maybe_pin(scan, &so->currPos);
+
+		/* Hint the kernel about the heap pages we're about to visit */
+		_bt_prefetch_heappages(scan, dir);
 	}
 
 	/* OK, itemIndex says what to return */
@@ -26,6 +26,7 @@
 #include "utils/lsyscache.h"
 #include "utils/memutils.h"
 #include "utils/rel.h"
+#include "utils/spccache.h"
 
 typedef void (*storeRes_func) (SpGistScanOpaque so, ItemPointer heapPtr,
 							   Datum leafValue, bool isNull,
@@ -103,11 +104,28 @@ spgFreeSearchItem(SpGistScanOpaque so, SpGistSearchItem *item)
  * Add SpGistSearchItem to queue
  *
  * Called in queue context
+ *
+ * Every non-leaf item in the queue will (redirects aside) be read with a
+ * synchronous ReadBuffer when it reaches the front, so this is the natural
+ * point to get the page's I/O started: by the time spgWalk visits the item,
+ * the read has had the whole remaining queue-drain time to complete.  We cap
+ * the number of prefetches running ahead of the visit position so that an
+ * ordered (KNN) search, which may abandon much of its queue, cannot flood
+ * the request queue with pages it will never read.
  */
 static void
 spgAddSearchItemToQueue(SpGistScanOpaque so, SpGistSearchItem *item)
 {
 	pairingheap_add(so->scanQueue, &item->phNode);
+
+#ifdef USE_PREFETCH
+	if (!item->isLeaf && so->prefetchPending < so->prefetchMaximum)
+	{
+		PrefetchBuffer(so->index, MAIN_FORKNUM,
+					   ItemPointerGetBlockNumber(&item->heapPtr));
+		so->prefetchPending++;
+	}
+#endif
 }
 
 static SpGistSearchItem *
@@ -161,6 +179,7 @@ resetSpGistScanOpaque(SpGistScanOpaque so)
 
 	/* initialize queue only for distance-ordered scans */
 	so->scanQueue = pairingheap_allocate(pairingheap_SpGistSearchItem_cmp, so);
+	so->prefetchPending = 0;
 
 	if (so->searchNulls)
 		/* Add a work item to scan the null index entries */
@@ -316,6 +335,12 @@ spgbeginscan(Relation rel, int keysz, int orderbysz)
 		so->keyData = NULL;
 	initSpGistState(&so->state, scan->indexRelation);
 
+	so->index = rel;
+#ifdef USE_PREFETCH
+	so->prefetchMaximum =
+		get_tablespace_io_concurrency(rel->rd_rel->reltablespace);
+#endif
+
 	so->tempCxt = AllocSetContextCreate(CurrentMemoryContext,
 										"SP-GiST search temporary context",
 										ALLOCSET_DEFAULT_SIZES);
@@ -745,11 +770,24 @@ spgInnerTest(SpGistScanOpaque so, SpGistSearchItem *item,
 static SpGistSearchItem *
 spgGetNextQueueItem(SpGistScanOpaque so)
 {
+	SpGistSearchItem *item;
+
 	if (pairingheap_is_empty(so->scanQueue))
 		return NULL;			/* Done when both heaps are empty */
 
+	item = (SpGistSearchItem *) pairingheap_remove_first(so->scanQueue);
+
+	/*
+	 * An inner item leaving the queue is about to be read, so its prefetch
+	 * (if any) is no longer pending.  This is an approximation --- the item
+	 * might have been enqueued after the prefetch budget ran out --- but it
+	 * only needs to keep the in-flight count roughly bounded.
+	 */
+	if (!item->isLeaf && so->prefetchPending > 0)
+		so->prefetchPending--;
+
 	/* Return item; caller is responsible to pfree it */
-	return (SpGistSearchItem *) pairingheap_remove_first(so->scanQueue);
+	return item;
 }
 
 enum SpGistSpecialOffsetNumbers
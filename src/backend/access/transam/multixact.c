@@ -323,6 +323,21 @@ static dlist_head MXactCache = DLIST_STATIC_INIT(MXactCache);
 static int	MXactCacheMembers = 0;
 static MemoryContext MXactContext = NULL;
 
+/*
+ * Hash table over the cache entries, keyed by MultiXactId, so that
+ * mXactCacheGetById() need not walk the LRU list.  That lookup runs once
+ * per multixact encountered during visibility checks, so on SELECT FOR
+ * SHARE workloads it's far too hot for a linear search.  (Lookup by member
+ * set only happens when creating a multixact, so it stays a list walk.)
+ */
+typedef struct mXactCacheIdEnt
+{
+	MultiXactId multi;			/* hash key */
+	mXactCacheEnt *entry;
+} mXactCacheIdEnt;
+
+static HTAB *MXactCacheById = NULL;
+
 #ifdef MULTIXACT_DEBUG
 #define debug_elog2(a,b) elog(a,b)
 #define debug_elog3(a,b,c) elog(a,b,c)
@@ -1538,43 +1553,39 @@ mXactCacheGetBySet(int nmembers, MultiXactMember *members)
 static int
 mXactCacheGetById(MultiXactId multi, MultiXactMember **members)
 {
-	dlist_iter	iter;
+	mXactCacheIdEnt *ident;
+	mXactCacheEnt *entry;
+	MultiXactMember *ptr;
+	Size		size;
 
 	debug_elog3(DEBUG2, "CacheGet: looking for %u", multi);
 
-	dlist_foreach(iter, &MXactCache)
-	{
-		mXactCacheEnt *entry = dlist_container(mXactCacheEnt, node, iter.cur);
+	if (MXactCacheById == NULL)
+		return -1;
 
-		if (entry->multi == multi)
-		{
-			MultiXactMember *ptr;
-			Size		size;
+	ident = (mXactCacheIdEnt *) hash_search(MXactCacheById, &multi,
+											HASH_FIND, NULL);
+	if (ident == NULL)
+	{
+		debug_elog2(DEBUG2, "CacheGet: not found");
+		return -1;
+	}
 
-			size = sizeof(MultiXactMember) * entry->nmembers;
-			ptr = (MultiXactMember *) palloc(size);
+	entry = ident->entry;
 
-			memcpy(ptr, entry->members, size);
+	size = sizeof(MultiXactMember) * entry->nmembers;
+	ptr = (MultiXactMember *) palloc(size);
 
-			debug_elog3(DEBUG2, "CacheGet: found %s",
-						mxid_to_string(multi,
-									   entry->nmembers,
-									   entry->members));
+	memcpy(ptr, entry->members, size);
 
-			/*
-			 * Note we modify the list while not using a modifiable iterator.
-			 * This is acceptable only because we exit the iteration
-			 * immediately afterwards.
-			 */
-			dlist_move_head(&MXactCache, iter.cur);
+	debug_elog3(DEBUG2, "CacheGet: found %s",
+				mxid_to_string(multi, entry->nmembers, entry->members));
 
-			*members = ptr;
-			return entry->nmembers;
-		}
-	}
+	/* keep the LRU list ordered for mXactCachePut's eviction choice */
+	dlist_move_head(&MXactCache, &entry->node);
 
-	debug_elog2(DEBUG2, "CacheGet: not found");
-	return -1;
+	*members = ptr;
+	return entry->nmembers;
 }
 
 /*
@@ -1591,11 +1602,22 @@ mXactCachePut(MultiXactId multi, int nmembers, MultiXactMember *members)
 
 	if (MXactContext == NULL)
 	{
+		HASHCTL		hash_ctl;
+
 		/* The cache only lives as long as the current transaction */
 		debug_elog2(DEBUG2, "CachePut: initializing memory context");
 		MXactContext = AllocSetContextCreate(TopTransactionContext,
 											 "MultiXact cache context",
 											 ALLOCSET_SMALL_SIZES);
+
+		/* ... and so does the id lookup table over it */
+		hash_ctl.keysize = sizeof(MultiXactId);
+		hash_ctl.entrysize = sizeof(mXactCacheIdEnt);
+		hash_ctl.hcxt = MXactContext;
+		MXactCacheById = hash_create("MultiXact cache ids",
+									 MAX_CACHE_ENTRIES,
+									 &hash_ctl,
+									 HASH_ELEM | HASH_BLOBS | HASH_CONTEXT);
 	}
 
 	entry = (mXactCacheEnt *)
@@ -1611,6 +1633,15 @@ mXactCachePut(MultiXactId multi, int nmembers, MultiXactMember *members)
 	qsort(entry->members, nmembers, sizeof(MultiXactMember), mxactMemberComparator);
 
 	dlist_push_head(&MXactCache, &entry->node);
+
+	{
+		mXactCacheIdEnt *ident;
+
+		ident = (mXactCacheIdEnt *) hash_search(MXactCacheById, &multi,
+												HASH_ENTER, NULL);
+		ident->entry = entry;
+	}
+
 	if (MXactCacheMembers++ >= MAX_CACHE_ENTRIES)
 	{
 		dlist_node *node;
@@ -1623,6 +1654,7 @@ mXactCachePut(MultiXactId multi, int nmembers, MultiXactMember *members)
 		debug_elog3(DEBUG2, "CachePut: pruning cached multi %u",
 					entry->multi);
 
+		(void) hash_search(MXactCacheById, &entry->multi, HASH_REMOVE, NULL);
 		pfree(entry);
 	}
 }
@@ -1699,6 +1731,7 @@ AtEOXact_MultiXact(void)
 	 * a child of TopTransactionContext, we needn't delete it explicitly.
 	 */
 	MXactContext = NULL;
+	MXactCacheById = NULL;
 	dlist_init(&MXactCache);
 	MXactCacheMembers = 0;
 }
@@ -1766,6 +1799,7 @@ PostPrepare_MultiXact(TransactionId xid)
 	 * Discard the local MultiXactId cache like in AtEOXact_MultiXact.
 	 */
 	MXactContext = NULL;
+	MXactCacheById = NULL;
 	dlist_init(&MXactCache);
 	MXactCacheMembers = 0;
 }
@@ -1822,6 +1856,26 @@ multixact_twophase_postabort(TransactionId xid, uint16 info,
  * thus double memory.  Also, reserve space for the shared MultiXactState
  * struct and the per-backend MultiXactId arrays (two of those, too).
  */
+/*
+ * Number of shared buffers for the two multixact SLRUs.
+ *
+ * As with CLOGShmemBuffers(), scale with shared_buffers instead of using
+ * the (tiny) historical constants unconditionally.  The members area is
+ * kept twice the size of the offsets area, since each multixact occupies
+ * several member entries but only one offset entry.
+ */
+static Size
+MultiXactOffsetShmemBuffers(void)
+{
+	return Min(64, Max(NUM_MULTIXACTOFFSET_BUFFERS, NBuffers / 1024));
+}
+
+static Size
+MultiXactMemberShmemBuffers(void)
+{
+	return Min(128, Max(NUM_MULTIXACTMEMBER_BUFFERS, NBuffers / 512));
+}
+
 Size
 MultiXactShmemSize(void)
 {
@@ -1833,8 +1887,8 @@ MultiXactShmemSize(void)
 			 mul_size(sizeof(MultiXactId) * 2, MaxOldestSlot))
 
 	size = SHARED_MULTIXACT_STATE_SIZE;
-	size = add_size(size, SimpleLruShmemSize(NUM_MULTIXACTOFFSET_BUFFERS, 0));
-	size = add_size(size, SimpleLruShmemSize(NUM_MULTIXACTMEMBER_BUFFERS, 0));
+	size = add_size(size, SimpleLruShmemSize(MultiXactOffsetShmemBuffers(), 0));
+	size = add_size(size, SimpleLruShmemSize(MultiXactMemberShmemBuffers(), 0));
 
 	return size;
 }
@@ -1850,13 +1904,13 @@ MultiXactShmemInit(void)
 	MultiXactMemberCtl->PagePrecedes = MultiXactMemberPagePrecedes;
 
 	SimpleLruInit(MultiXactOffsetCtl,
-				  "MultiXactOffset", NUM_MULTIXACTOFFSET_BUFFERS, 0,
+				  "MultiXactOffset", MultiXactOffsetShmemBuffers(), 0,
 				  MultiXactOffsetSLRULock, "pg_multixact/offsets",
 				  LWTRANCHE_MULTIXACTOFFSET_BUFFER,
 				  SYNC_HANDLER_MULTIXACT_OFFSET);
 	SlruPagePrecedesUnitTests(MultiXactOffsetCtl, MULTIXACT_OFFSETS_PER_PAGE);
 	SimpleLruInit(MultiXactMemberCtl,
-				  "MultiXactMember", NUM_MULTIXACTMEMBER_BUFFERS, 0,
+				  "MultiXactMember", MultiXactMemberShmemBuffers(), 0,
 				  MultiXactMemberSLRULock, "pg_multixact/members",
 				  LWTRANCHE_MULTIXACTMEMBER_BUFFER,
 				  SYNC_HANDLER_MULTIXACT_MEMBER);
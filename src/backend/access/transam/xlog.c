@@ -148,9 +148,10 @@ int			wal_segment_size = DEFAULT_XLOG_SEG_SIZE;
 /*
  * Number of WAL insertion locks to use. A higher value allows more insertions
  * to happen concurrently, but adds some CPU overhead to flushing the WAL,
- * which needs to iterate all the locks.
+ * which needs to iterate all the locks.  -1 means auto-tune from
+ * MaxConnections; the final value is settled in XLOGShmemSize().
  */
-#define NUM_XLOGINSERT_LOCKS  8
+int			NumXLogInsertLocks = -1;
 
 /*
  * Max distance from last checkpoint, before triggering a new xlog-based
@@ -689,6 +690,9 @@ static void CopyXLogRecordToWAL(int write_len, bool isLogSwitch,
 								TimeLineID tli);
 static void ReserveXLogInsertLocation(int size, XLogRecPtr *StartPos,
 									  XLogRecPtr *EndPos, XLogRecPtr *PrevPtr);
+static void ReserveXLogInsertLocationGroup(int size, uint64 *startbytepos,
+										   uint64 *endbytepos,
+										   uint64 *prevbytepos);
 static bool ReserveXLogSwitch(XLogRecPtr *StartPos, XLogRecPtr *EndPos,
 							  XLogRecPtr *PrevPtr);
 static XLogRecPtr WaitXLogInsertionsToFinish(XLogRecPtr upto);
@@ -781,7 +785,7 @@ XLogInsertRecord(XLogRecData *rdata,
 	 * inserter acquires an insertion lock. In addition to just indicating that
 	 * an insertion is in progress, the lock tells others how far the inserter
 	 * has progressed. There is a small fixed number of insertion locks,
-	 * determined by NUM_XLOGINSERT_LOCKS. When an inserter crosses a page
+	 * determined by NumXLogInsertLocks. When an inserter crosses a page
 	 * boundary, it updates the value stored in the lock to the how far it has
 	 * inserted, to allow the previous buffer to be flushed.
 	 *
@@ -1067,16 +1071,26 @@ ReserveXLogInsertLocation(int size, XLogRecPtr *StartPos, XLogRecPtr *EndPos,
 	 * positions (XLogRecPtrs) can be done outside the locked region, and
 	 * because the usable byte position doesn't include any headers, reserving
 	 * X bytes from WAL is almost as simple as "CurrBytePos += X".
+	 *
+	 * When the spinlock is observed busy, join a group reservation instead
+	 * of piling onto it: the backends queue up and a single leader assigns
+	 * positions for the whole queue in one lock acquisition.
 	 */
-	SpinLockAcquire(&Insert->insertpos_lck);
+	if (!SpinLockFree(&Insert->insertpos_lck))
+		ReserveXLogInsertLocationGroup(size, &startbytepos, &endbytepos,
+									   &prevbytepos);
+	else
+	{
+		SpinLockAcquire(&Insert->insertpos_lck);
 
-	startbytepos = Insert->CurrBytePos;
-	endbytepos = startbytepos + size;
-	prevbytepos = Insert->PrevBytePos;
-	Insert->CurrBytePos = endbytepos;
-	Insert->PrevBytePos = startbytepos;
+		startbytepos = Insert->CurrBytePos;
+		endbytepos = startbytepos + size;
+		prevbytepos = Insert->PrevBytePos;
+		Insert->CurrBytePos = endbytepos;
+		Insert->PrevBytePos = startbytepos;
 
-	SpinLockRelease(&Insert->insertpos_lck);
+		SpinLockRelease(&Insert->insertpos_lck);
+	}
 
 	*StartPos = XLogBytePosToRecPtr(startbytepos);
 	*EndPos = XLogBytePosToEndRecPtr(endbytepos);
@@ -1091,6 +1105,137 @@ ReserveXLogInsertLocation(int size, XLogRecPtr *StartPos, XLogRecPtr *EndPos,
 	Assert(XLogRecPtrToBytePos(*PrevPtr) == prevbytepos);
 }
 
+/*
+ * When insertpos_lck cannot be expected immediately, add ourselves to a
+ * list of processes that need a WAL insert-position reservation.  The first
+ * process to add itself to the list will acquire the spinlock and assign
+ * byte positions to all group members in one go, exactly as if each of them
+ * had taken the spinlock in turn.  This avoids a great deal of contention
+ * on the spinlock cacheline when many backends insert WAL at once, since
+ * the lock need not be repeatedly handed off from one inserter to the next.
+ *
+ * This is the same scheme TransactionGroupUpdateXidStatus() uses for
+ * batching clog updates.
+ */
+static void
+ReserveXLogInsertLocationGroup(int size, uint64 *startbytepos,
+							   uint64 *endbytepos, uint64 *prevbytepos)
+{
+	XLogCtlInsert *Insert = &XLogCtl->Insert;
+	PROC_HDR   *procglobal = ProcGlobal;
+	PGPROC	   *proc = MyProc;
+	uint32		nextidx;
+	uint32		wakeidx;
+
+	/* Add ourselves to the list of processes needing a reservation. */
+	proc->walReserveMember = true;
+	proc->walReserveSize = size;
+
+	nextidx = pg_atomic_read_u32(&procglobal->walReserveFirst);
+
+	while (true)
+	{
+		pg_atomic_write_u32(&proc->walReserveNext, nextidx);
+
+		if (pg_atomic_compare_exchange_u32(&procglobal->walReserveFirst,
+										   &nextidx,
+										   (uint32) proc->pgprocno))
+			break;
+	}
+
+	/*
+	 * If the list was not empty, the leader will make our reservation.  It
+	 * is impossible to have followers without a leader because the first
+	 * process that has added itself to the list will always have nextidx as
+	 * INVALID_PGPROCNO.
+	 */
+	if (nextidx != INVALID_PGPROCNO)
+	{
+		int			extraWaits = 0;
+
+		/* Sleep until the leader assigns our byte positions. */
+		pgstat_report_wait_start(WAIT_EVENT_WAL_GROUP_RESERVE);
+		for (;;)
+		{
+			/* acts as a read barrier */
+			PGSemaphoreLock(proc->sem);
+			if (!proc->walReserveMember)
+				break;
+			extraWaits++;
+		}
+		pgstat_report_wait_end();
+
+		Assert(pg_atomic_read_u32(&proc->walReserveNext) == INVALID_PGPROCNO);
+
+		/* Fix semaphore count for any absorbed wakeups */
+		while (extraWaits-- > 0)
+			PGSemaphoreUnlock(proc->sem);
+
+		*startbytepos = proc->walReserveStart;
+		*endbytepos = proc->walReserveEnd;
+		*prevbytepos = proc->walReservePrev;
+		return;
+	}
+
+	/* We are the leader.  Acquire the spinlock on behalf of everyone. */
+	SpinLockAcquire(&Insert->insertpos_lck);
+
+	/*
+	 * Now that we've got the lock, clear the list of processes waiting for
+	 * a reservation, saving a pointer to the head of the list.  Trying to
+	 * pop elements one at a time could lead to an ABA problem.
+	 */
+	nextidx = pg_atomic_exchange_u32(&procglobal->walReserveFirst,
+									 INVALID_PGPROCNO);
+
+	/* Remember head of list so we can perform wakeups after dropping lock. */
+	wakeidx = nextidx;
+
+	/* Walk the list and assign positions to all members. */
+	while (nextidx != INVALID_PGPROCNO)
+	{
+		PGPROC	   *nextproc = &ProcGlobal->allProcs[nextidx];
+		uint64		start = Insert->CurrBytePos;
+
+		nextproc->walReserveStart = start;
+		nextproc->walReserveEnd = start + nextproc->walReserveSize;
+		nextproc->walReservePrev = Insert->PrevBytePos;
+		Insert->CurrBytePos = nextproc->walReserveEnd;
+		Insert->PrevBytePos = start;
+
+		/* Move to next proc in list. */
+		nextidx = pg_atomic_read_u32(&nextproc->walReserveNext);
+	}
+
+	/* We're done with the lock now. */
+	SpinLockRelease(&Insert->insertpos_lck);
+
+	/*
+	 * Now that we've released the lock, go back and wake everybody up.  We
+	 * don't do this under the lock so as to keep lock hold times to a
+	 * minimum.
+	 */
+	while (wakeidx != INVALID_PGPROCNO)
+	{
+		PGPROC	   *nextproc = &ProcGlobal->allProcs[wakeidx];
+
+		wakeidx = pg_atomic_read_u32(&nextproc->walReserveNext);
+		pg_atomic_write_u32(&nextproc->walReserveNext, INVALID_PGPROCNO);
+
+		/* ensure all previous writes are visible before follower continues. */
+		pg_write_barrier();
+
+		nextproc->walReserveMember = false;
+
+		if (nextproc != MyProc)
+			PGSemaphoreUnlock(nextproc->sem);
+	}
+
+	*startbytepos = proc->walReserveStart;
+	*endbytepos = proc->walReserveEnd;
+	*prevbytepos = proc->walReservePrev;
+}
+
 /*
  * Like ReserveXLogInsertLocation(), but for an xlog-switch record.
  *
@@ -1324,7 +1469,7 @@ WALInsertLockAcquire(void)
 	static int	lockToTry = -1;
 
 	if (lockToTry == -1)
-		lockToTry = MyProc->pgprocno % NUM_XLOGINSERT_LOCKS;
+		lockToTry = MyProc->pgprocno % NumXLogInsertLocks;
 	MyLockNo = lockToTry;
 
 	/*
@@ -1342,13 +1487,18 @@ WALInsertLockAcquire(void)
 		 * than locks, it still helps to distribute the inserters evenly
 		 * across the locks.
 		 */
-		lockToTry = (lockToTry + 1) % NUM_XLOGINSERT_LOCKS;
+		lockToTry = (lockToTry + 1) % NumXLogInsertLocks;
 	}
 }
 
 /*
  * Acquire all WAL insertion locks, to prevent other backends from inserting
  * to WAL.
+ *
+ * Since this takes NumXLogInsertLocks locks simultaneously, the upper limit
+ * of the wal_insert_locks GUC must be kept well below MAX_SIMUL_LWLOCKS
+ * (see lwlock.c); otherwise every checkpoint would fail with "too many
+ * LWLocks taken".
  */
 static void
 WALInsertLockAcquireExclusive(void)
@@ -1360,7 +1510,7 @@ WALInsertLockAcquireExclusive(void)
 	 * indicator is set to 0xFFFFFFFFFFFFFFFF, which is higher than any real
 	 * XLogRecPtr value, to make sure that no-one blocks waiting on those.
 	 */
-	for (i = 0; i < NUM_XLOGINSERT_LOCKS - 1; i++)
+	for (i = 0; i < NumXLogInsertLocks - 1; i++)
 	{
 		LWLockAcquire(&WALInsertLocks[i].l.lock, LW_EXCLUSIVE);
 		LWLockUpdateVar(&WALInsertLocks[i].l.lock,
@@ -1386,7 +1536,7 @@ WALInsertLockRelease(void)
 	{
 		int			i;
 
-		for (i = 0; i < NUM_XLOGINSERT_LOCKS; i++)
+		for (i = 0; i < NumXLogInsertLocks; i++)
 			LWLockReleaseClearVar(&WALInsertLocks[i].l.lock,
 								  &WALInsertLocks[i].l.insertingAt,
 								  0);
@@ -1414,8 +1564,8 @@ WALInsertLockUpdateInsertingAt(XLogRecPtr insertingAt)
 		 * We use the last lock to mark our actual position, see comments in
 		 * WALInsertLockAcquireExclusive.
 		 */
-		LWLockUpdateVar(&WALInsertLocks[NUM_XLOGINSERT_LOCKS - 1].l.lock,
-						&WALInsertLocks[NUM_XLOGINSERT_LOCKS - 1].l.insertingAt,
+		LWLockUpdateVar(&WALInsertLocks[NumXLogInsertLocks - 1].l.lock,
+						&WALInsertLocks[NumXLogInsertLocks - 1].l.insertingAt,
 						insertingAt);
 	}
 	else
@@ -1482,7 +1632,7 @@ WaitXLogInsertionsToFinish(XLogRecPtr upto)
 	 * out for any insertion that's still in progress.
 	 */
 	finishedUpto = reservedUpto;
-	for (i = 0; i < NUM_XLOGINSERT_LOCKS; i++)
+	for (i = 0; i < NumXLogInsertLocks; i++)
 	{
 		XLogRecPtr	insertingat = InvalidXLogRecPtr;
 
@@ -2239,6 +2389,27 @@ XLogWrite(XLogwrtRqst WriteRqst, TimeLineID tli, bool flexible)
 
 			npages = 0;
 
+#ifdef HAVE_SYNC_FILE_RANGE
+			/*
+			 * If this batch won't be fsync'd before we return -- neither by
+			 * the segment-end fsync below nor by the flush-request check
+			 * after the loop -- ask the kernel to start writing it back now.
+			 * That overlaps the device write with continuing WAL inserts, so
+			 * a later commit-time flush finds the data already in flight and
+			 * completes sooner.  Skip partial pages, since they'll be
+			 * rewritten when the page fills.  This is only a hint, so errors
+			 * are ignored; and it's pointless with the open_sync methods,
+			 * which have already synced the data.
+			 */
+			if (!finishing_seg && !ispartialpage &&
+				WriteRqst.Flush < LogwrtResult.Write &&
+				sync_method != SYNC_METHOD_OPEN &&
+				sync_method != SYNC_METHOD_OPEN_DSYNC)
+				(void) sync_file_range(openLogFile,
+									   startoffset - nbytes, nbytes,
+									   SYNC_FILE_RANGE_WRITE);
+#endif
+
 			/*
 			 * If we just wrote the whole last page of a logfile segment,
 			 * fsync the segment immediately.  This avoids having to go back
@@ -4277,6 +4448,47 @@ XLOGChooseNumBuffers(void)
 	return xbuffers;
 }
 
+/*
+ * Returns the auto-tuned number of WAL insertion locks.  Insert-heavy
+ * many-core workloads want more than the historical 8, but there is little
+ * point in having more locks than backends that can insert concurrently,
+ * and WAL flushes must iterate all of them.
+ */
+static int
+XLOGChooseNumInsertLocks(void)
+{
+	return Min(Max(MaxConnections / 4, 8), 64);
+}
+
+/*
+ * GUC check_hook for wal_insert_locks
+ */
+bool
+check_wal_insert_locks(int *newval, void **extra, GucSource source)
+{
+	/*
+	 * -1 indicates a request for auto-tune.
+	 */
+	if (*newval == -1)
+	{
+		/*
+		 * If we haven't yet changed the boot_val default of -1, just let it
+		 * be.  We'll fix it when XLOGShmemSize is called.
+		 */
+		if (NumXLogInsertLocks == -1)
+			return true;
+
+		/* Otherwise, substitute the auto-tune value */
+		*newval = XLOGChooseNumInsertLocks();
+	}
+
+	/* Silently treat nonsensical values as a request for the minimum. */
+	if (*newval < 1)
+		*newval = 1;
+
+	return true;
+}
+
 /*
  * GUC check_hook for wal_buffers
  */
@@ -4530,11 +4742,25 @@ XLOGShmemSize(void)
 	}
 	Assert(XLOGbuffers > 0);
 
+	/* Similarly resolve a wal_insert_locks value of -1 to its auto-tune. */
+	if (NumXLogInsertLocks == -1)
+	{
+		char		buf[32];
+
+		snprintf(buf, sizeof(buf), "%d", XLOGChooseNumInsertLocks());
+		SetConfigOption("wal_insert_locks", buf, PGC_POSTMASTER,
+						PGC_S_DYNAMIC_DEFAULT);
+		if (NumXLogInsertLocks == -1)	/* failed to apply it? */
+			SetConfigOption("wal_insert_locks", buf, PGC_POSTMASTER,
+							PGC_S_OVERRIDE);
+	}
+	Assert(NumXLogInsertLocks > 0);
+
 	/* XLogCtl */
 	size = sizeof(XLogCtlData);
 
 	/* WAL insertion locks, plus alignment */
-	size = add_size(size, mul_size(sizeof(WALInsertLockPadded), NUM_XLOGINSERT_LOCKS + 1));
+	size = add_size(size, mul_size(sizeof(WALInsertLockPadded), NumXLogInsertLocks + 1));
 	/* xlblocks array */
 	size = add_size(size, mul_size(sizeof(XLogRecPtr), XLOGbuffers));
 	/* extra alignment padding for XLOG I/O buffers */
@@ -4624,9 +4850,9 @@ XLOGShmemInit(void)
 		((uintptr_t) allocptr) % sizeof(WALInsertLockPadded);
 	WALInsertLocks = XLogCtl->Insert.WALInsertLocks =
 		(WALInsertLockPadded *) allocptr;
-	allocptr += sizeof(WALInsertLockPadded) * NUM_XLOGINSERT_LOCKS;
+	allocptr += sizeof(WALInsertLockPadded) * NumXLogInsertLocks;
 
-	for (i = 0; i < NUM_XLOGINSERT_LOCKS; i++)
+	for (i = 0; i < NumXLogInsertLocks; i++)
 	{
 		LWLockInitialize(&WALInsertLocks[i].l.lock, LWTRANCHE_WAL_INSERT);
 		WALInsertLocks[i].l.insertingAt = InvalidXLogRecPtr;
@@ -6140,7 +6366,7 @@ GetLastImportantRecPtr(void)
 	XLogRecPtr	res = InvalidXLogRecPtr;
 	int			i;
 
-	for (i = 0; i < NUM_XLOGINSERT_LOCKS; i++)
+	for (i = 0; i < NumXLogInsertLocks; i++)
 	{
 		XLogRecPtr	last_important;
 
@@ -18,7 +18,8 @@
  * recorded in the decoded record so that XLogReadBufferForRedo() can try to
  * avoid a second buffer mapping table lookup.
  *
- * Currently, only the main fork is considered for prefetching.  Currently,
+ * All forks referenced by WAL records are considered for prefetching,
+ * including the free space map and visibility map forks.  Currently,
  * prefetching is only effective on systems where BufferPrefetch() does
  * something useful (mainly Linux).
  *
@@ -141,6 +142,7 @@ struct XLogPrefetcher
 
 	/* Book-keeping to avoid repeat prefetches. */
 	RelFileLocator recent_rlocator[XLOGPREFETCHER_SEQ_WINDOW_SIZE];
+	ForkNumber	recent_forknum[XLOGPREFETCHER_SEQ_WINDOW_SIZE];
 	BlockNumber recent_block[XLOGPREFETCHER_SEQ_WINDOW_SIZE];
 	int			recent_idx;
 
@@ -451,8 +453,8 @@ XLogPrefetcherComputeStats(XLogPrefetcher *prefetcher)
  *
  * Returns LRQ_NEXT_AGAIN if no more WAL data is available yet.
  *
- * Returns LRQ_NEXT_IO if the next block reference is for a main fork block
- * that isn't in the buffer pool, and the kernel has been asked to start
+ * Returns LRQ_NEXT_IO if the next block reference is for a block that isn't
+ * in the buffer pool, and the kernel has been asked to start
  * reading it to make a future read system call faster. An LSN is written to
  * *lsn, and the I/O will be considered to have completed once that LSN is
  * replayed.
@@ -667,12 +669,6 @@ XLogPrefetcherNextBlock(uintptr_t pgsr_private, XLogRecPtr *lsn)
 			 */
 			*lsn = record->lsn;
 
-			/* We don't try to prefetch anything but the main fork for now. */
-			if (block->forknum != MAIN_FORKNUM)
-			{
-				return LRQ_NEXT_NO_IO;
-			}
-
 			/*
 			 * If there is a full page image attached, we won't be reading the
 			 * page, so don't bother trying to prefetch.
@@ -701,6 +697,7 @@ XLogPrefetcherNextBlock(uintptr_t pgsr_private, XLogRecPtr *lsn)
 			for (int i = 0; i < XLOGPREFETCHER_SEQ_WINDOW_SIZE; ++i)
 			{
 				if (block->blkno == prefetcher->recent_block[i] &&
+					block->forknum == prefetcher->recent_forknum[i] &&
 					RelFileLocatorEquals(block->rlocator, prefetcher->recent_rlocator[i]))
 				{
 					/*
@@ -713,6 +710,7 @@ XLogPrefetcherNextBlock(uintptr_t pgsr_private, XLogRecPtr *lsn)
 				}
 			}
 			prefetcher->recent_rlocator[prefetcher->recent_idx] = block->rlocator;
+			prefetcher->recent_forknum[prefetcher->recent_idx] = block->forknum;
 			prefetcher->recent_block[prefetcher->recent_idx] = block->blkno;
 			prefetcher->recent_idx =
 				(prefetcher->recent_idx + 1) % XLOGPREFETCHER_SEQ_WINDOW_SIZE;
@@ -731,7 +729,7 @@ XLogPrefetcherNextBlock(uintptr_t pgsr_private, XLogRecPtr *lsn)
 			 * further prefetching in the relation until this record is
 			 * replayed.
 			 */
-			if (!smgrexists(reln, MAIN_FORKNUM))
+			if (!smgrexists(reln, block->forknum))
 			{
 #ifdef XLOGPREFETCHER_DEBUG_LEVEL
 				elog(XLOGPREFETCHER_DEBUG_LEVEL,
@@ -1821,6 +1821,8 @@ typedef struct
 {
 	SortSupport ssup;
 	int		   *tupnoLink;
+	Datum	   *abbrevs;		/* abbreviated keys, indexed by tupno, or
+								 * NULL if not using abbreviation */
 } CompareScalarsContext;
 
 
@@ -2381,6 +2383,8 @@ compute_scalar_stats(VacAttrStatsP stats,
 	SortSupportData ssup;
 	ScalarItem *values;
 	int			values_cnt = 0;
+	Datum	   *abbrevs = NULL;
+	int			abbrev_next = 10;
 	int		   *tupnoLink;
 	ScalarMCVItem *track;
 	int			track_cnt = 0;
@@ -2398,14 +2402,20 @@ compute_scalar_stats(VacAttrStatsP stats,
 	ssup.ssup_nulls_first = false;
 
 	/*
-	 * For now, don't perform abbreviated key conversion, because full values
-	 * are required for MCV slot generation.  Supporting that optimization
-	 * would necessitate teaching compare_scalars() to call a tie-breaker.
+	 * Use abbreviated keys if the type supports them; sorting the sample
+	 * dominates the cost of ANALYZE for types with expensive comparisons.
+	 * The abbreviations are kept in a separate array so that the full
+	 * values remain available for MCV and histogram slot generation, and
+	 * compare_scalars() falls back to the authoritative comparator whenever
+	 * two abbreviations compare equal.
 	 */
-	ssup.abbreviate = false;
+	ssup.abbreviate = true;
 
 	PrepareSortSupportFromOrderingOp(mystats->ltopr, &ssup);
 
+	if (ssup.abbrev_converter != NULL)
+		abbrevs = (Datum *) palloc(samplerows * sizeof(Datum));
+
 	/* Initial scan to find sortable values */
 	for (i = 0; i < samplerows; i++)
 	{
@@ -2454,6 +2464,29 @@ compute_scalar_stats(VacAttrStatsP stats,
 			total_width += strlen(DatumGetCString(value)) + 1;
 		}
 
+		if (ssup.abbrev_converter != NULL)
+		{
+			/*
+			 * Periodically check whether abbreviation remains worthwhile,
+			 * on the same doubling schedule tuplesort uses.  If the opclass
+			 * votes to abort, revert to the authoritative comparator; any
+			 * abbreviations made so far are simply ignored.
+			 */
+			if (values_cnt >= abbrev_next)
+			{
+				abbrev_next *= 2;
+				if (ssup.abbrev_abort(values_cnt, &ssup))
+				{
+					ssup.comparator = ssup.abbrev_full_comparator;
+					ssup.abbrev_converter = NULL;
+					ssup.abbrev_abort = NULL;
+					ssup.abbrev_full_comparator = NULL;
+				}
+			}
+			if (ssup.abbrev_converter != NULL)
+				abbrevs[values_cnt] = ssup.abbrev_converter(value, &ssup);
+		}
+
 		/* Add it to the list to be sorted */
 		values[values_cnt].value = value;
 		values[values_cnt].tupno = values_cnt;
@@ -2474,6 +2507,7 @@ compute_scalar_stats(VacAttrStatsP stats,
 		/* Sort the collected values */
 		cxt.ssup = &ssup;
 		cxt.tupnoLink = tupnoLink;
+		cxt.abbrevs = (ssup.abbrev_converter != NULL) ? abbrevs : NULL;
 		qsort_interruptible((void *) values, values_cnt, sizeof(ScalarItem),
 							compare_scalars, (void *) &cxt);
 
@@ -2901,7 +2935,19 @@ compare_scalars(const void *a, const void *b, void *arg)
 	CompareScalarsContext *cxt = (CompareScalarsContext *) arg;
 	int			compare;
 
-	compare = ApplySortComparator(da, false, db, false, cxt->ssup);
+	if (cxt->abbrevs != NULL)
+	{
+		/* Compare abbreviations first; resolve ties authoritatively */
+		compare = ApplySortComparator(cxt->abbrevs[ta], false,
+									  cxt->abbrevs[tb], false,
+									  cxt->ssup);
+		if (compare != 0)
+			return compare;
+		compare = ApplySortAbbrevFullComparator(da, false, db, false,
+												cxt->ssup);
+	}
+	else
+		compare = ApplySortComparator(da, false, db, false, cxt->ssup);
 	if (compare != 0)
 		return compare;
 
@@ -1119,10 +1119,15 @@ CopyFrom(CopyFromState cstate)
 			 * We count only tuples not suppressed by a BEFORE INSERT trigger
 			 * or FDW; this is the same definition used by nodeModifyTable.c
 			 * for counting tuples inserted by an INSERT command.  Update
-			 * progress of the COPY command as well.
+			 * progress of the COPY command as well, but only once per
+			 * MAX_BUFFERED_TUPLES rows: the shared-memory writes done by
+			 * pgstat_progress_update_param() add up when loading millions of
+			 * rows, and nothing needs row-accurate progress.  The exact
+			 * count is reported once more after the loop.
 			 */
-			pgstat_progress_update_param(PROGRESS_COPY_TUPLES_PROCESSED,
-										 ++processed);
+			if ((++processed) % MAX_BUFFERED_TUPLES == 0)
+				pgstat_progress_update_param(PROGRESS_COPY_TUPLES_PROCESSED,
+											 processed);
 		}
 	}
 
@@ -1133,6 +1138,9 @@ CopyFrom(CopyFromState cstate)
 			CopyMultiInsertInfoFlush(&multiInsertInfo, NULL);
 	}
 
+	/* Report the final row count */
+	pgstat_progress_update_param(PROGRESS_COPY_TUPLES_PROCESSED, processed);
+
 	/* Done, clean up */
 	error_context_stack = errcallback.previous;
 
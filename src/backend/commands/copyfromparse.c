@@ -72,6 +72,7 @@
 #include "miscadmin.h"
 #include "pgstat.h"
 #include "port/pg_bswap.h"
+#include "port/simd.h"
 #include "utils/builtins.h"
 #include "utils/memutils.h"
 #include "utils/rel.h"
@@ -1202,6 +1203,38 @@ CopyReadLineText(CopyFromState cstate)
 			need_data = false;
 		}
 
+		/*
+		 * Dash ahead over ordinary characters.  In text mode, only '\r',
+		 * '\n' and '\\' can affect this loop's state, so scan for them a
+		 * vector at a time and skip over everything else.  Bytes of
+		 * multibyte characters all have their high bit set and the
+		 * characters of interest are all ASCII, so false matches within
+		 * multibyte data are not possible.  (In CSV mode the quote and
+		 * escape characters and the quoting state would have to be
+		 * considered as well, so we process it byte by byte.)
+		 *
+		 * The loop must stop short of consuming the whole buffer: the
+		 * unconditional fetch below would otherwise read the terminating
+		 * '\0' past input_buf_len as data.  Leaving at least one byte
+		 * unexamined keeps the fetch in bounds; the refill test at the top
+		 * of the outer loop then handles buffer exhaustion as usual.
+		 */
+		if (!cstate->opts.csv_mode)
+		{
+			while (input_buf_ptr + sizeof(Vector8) < copy_buf_len)
+			{
+				Vector8		chunk;
+
+				vector8_load(&chunk,
+							 (const uint8 *) &copy_input_buf[input_buf_ptr]);
+				if (vector8_has(chunk, '\n') ||
+					vector8_has(chunk, '\r') ||
+					vector8_has(chunk, '\\'))
+					break;
+				input_buf_ptr += sizeof(Vector8);
+			}
+		}
+
 		/* OK to fetch a character */
 		prev_raw_ptr = input_buf_ptr;
 		c = copy_input_buf[input_buf_ptr++];
@@ -95,7 +95,6 @@ static bool vacuum_rel(Oid relid, RangeVar *relation, VacuumParams *params);
 static double compute_parallel_delay(void);
 static VacOptValue get_vacoptval_from_boolean(DefElem *def);
 static bool vac_tid_reaped(ItemPointer itemptr, void *state);
-static int	vac_cmp_itemptr(const void *left, const void *right);
 
 /*
  * Primary entry point for manual VACUUM and ANALYZE commands
@@ -2361,56 +2360,42 @@ vac_tid_reaped(ItemPointer itemptr, void *state)
 	int64		litem,
 				ritem,
 				item;
-	ItemPointer res;
+	int			lo,
+				hi;
 
 	litem = itemptr_encode(&dead_items->items[0]);
 	ritem = itemptr_encode(&dead_items->items[dead_items->num_items - 1]);
 	item = itemptr_encode(itemptr);
 
 	/*
-	 * Doing a simple bound check before bsearch() is useful to avoid the
-	 * extra cost of bsearch(), especially if dead items on the heap are
-	 * concentrated in a certain range.  Since this function is called for
-	 * every index tuple, it pays to be really fast.
+	 * Doing a simple bound check before the search is useful to avoid its
+	 * cost entirely, especially if dead items on the heap are concentrated
+	 * in a certain range.  Since this function is called for every index
+	 * tuple, it pays to be really fast.
 	 */
 	if (item < litem || item > ritem)
 		return false;
 
-	res = (ItemPointer) bsearch((void *) itemptr,
-								(void *) dead_items->items,
-								dead_items->num_items,
-								sizeof(ItemPointerData),
-								vac_cmp_itemptr);
-
-	return (res != NULL);
-}
-
-/*
- * Comparator routines for use with qsort() and bsearch().
- */
-static int
-vac_cmp_itemptr(const void *left, const void *right)
-{
-	BlockNumber lblk,
-				rblk;
-	OffsetNumber loff,
-				roff;
-
-	lblk = ItemPointerGetBlockNumber((ItemPointer) left);
-	rblk = ItemPointerGetBlockNumber((ItemPointer) right);
-
-	if (lblk < rblk)
-		return -1;
-	if (lblk > rblk)
-		return 1;
-
-	loff = ItemPointerGetOffsetNumber((ItemPointer) left);
-	roff = ItemPointerGetOffsetNumber((ItemPointer) right);
+	/*
+	 * Open-coded binary search on the encoded representation.  Compared to
+	 * bsearch() with vac_cmp_itemptr, this saves an indirect function call
+	 * per step and compares TIDs with a single int64 comparison instead of
+	 * unpacking block and offset numbers separately.
+	 */
+	lo = 0;
+	hi = dead_items->num_items - 1;
+	while (lo <= hi)
+	{
+		int			mid = lo + (hi - lo) / 2;
+		int64		miditem = itemptr_encode(&dead_items->items[mid]);
 
-	if (loff < roff)
-		return -1;
-	if (loff > roff)
-		return 1;
+		if (item > miditem)
+			lo = mid + 1;
+		else if (item < miditem)
+			hi = mid - 1;
+		else
+			return true;
+	}
 
-	return 0;
+	return false;
 }
@@ -25,11 +25,13 @@
 #include "mb/pg_wchar.h"
 #include "miscadmin.h"
 #include "nodes/makefuncs.h"
+#include "nodes/nodeFuncs.h"
 #include "partitioning/partbounds.h"
 #include "partitioning/partdesc.h"
 #include "partitioning/partprune.h"
 #include "rewrite/rewriteManip.h"
 #include "utils/acl.h"
+#include "utils/datum.h"
 #include "utils/lsyscache.h"
 #include "utils/partcache.h"
 #include "utils/rls.h"
@@ -192,6 +194,14 @@ static void InitPartitionPruneContext(PartitionPruneContext *context,
 									  PartitionKey partkey,
 									  PlanState *planstate,
 									  ExprContext *econtext);
+static void InitPruneResultCache(PartitionPruneState *prunestate,
+								 PartitionPruneInfo *pruneinfo);
+static bool prune_param_types_walker(Node *node,
+									 PartitionPruneState *prunestate);
+static bool LookupPruneResultCache(PartitionPruneState *prunestate,
+								   Bitmapset **result);
+static void SavePruneResultCache(PartitionPruneState *prunestate,
+								 Bitmapset *result);
 static void PartitionPruneFixSubPlanMap(PartitionPruneState *prunestate,
 										Bitmapset *initially_valid_subplans,
 										int n_total_subplans);
@@ -1884,6 +1894,11 @@ CreatePartitionPruneState(PlanState *planstate, PartitionPruneInfo *pruneinfo)
 	prunestate->other_subplans = bms_copy(pruneinfo->other_subplans);
 	prunestate->do_initial_prune = false;	/* may be set below */
 	prunestate->do_exec_prune = false;	/* may be set below */
+	prunestate->econtext = econtext;
+	prunestate->cachecontext = CurrentMemoryContext;
+	prunestate->nexecparams = 0;	/* may be set by InitPruneResultCache */
+	prunestate->cachevalid = false;
+	prunestate->cacheresult = NULL;
 	prunestate->num_partprunedata = n_part_hierarchies;
 
 	/*
@@ -2064,9 +2079,211 @@ CreatePartitionPruneState(PlanState *planstate, PartitionPruneInfo *pruneinfo)
 		i++;
 	}
 
+	/* Try to enable caching of exec-time pruning results */
+	if (prunestate->do_exec_prune)
+		InitPruneResultCache(prunestate, pruneinfo);
+
 	return prunestate;
 }
 
+/*
+ * InitPruneResultCache
+ *		Set up the single-entry cache of exec-time pruning results
+ *
+ * The cache key is the set of PARAM_EXEC parameter values the pruning steps
+ * depend on, so we must be able to compare (and copy) the value of each such
+ * parameter; collect the parameters' type information from the Param nodes
+ * within the pruning step expressions.  If we somehow fail to find a Param
+ * for each member of "execparamids", just leave the cache disabled.
+ */
+static void
+InitPruneResultCache(PartitionPruneState *prunestate,
+					 PartitionPruneInfo *pruneinfo)
+{
+	int			nexecparams = bms_num_members(prunestate->execparamids);
+	int			paramid;
+	int			i;
+	ListCell   *lc;
+
+	if (nexecparams <= 0)
+		return;
+
+	prunestate->cacheparamids = (int *) palloc(sizeof(int) * nexecparams);
+	prunestate->cachetyplens = (int16 *) palloc0(sizeof(int16) * nexecparams);
+	prunestate->cachetypbyvals = (bool *) palloc(sizeof(bool) * nexecparams);
+	prunestate->cachevalues = (Datum *) palloc(sizeof(Datum) * nexecparams);
+	prunestate->cacheisnulls = (bool *) palloc(sizeof(bool) * nexecparams);
+
+	i = 0;
+	paramid = -1;
+	while ((paramid = bms_next_member(prunestate->execparamids, paramid)) >= 0)
+		prunestate->cacheparamids[i++] = paramid;
+
+	/*
+	 * Search the pruning step expressions of all hierarchies for PARAM_EXEC
+	 * Params, filling in the type info for each execparamids member found.
+	 * A zero typlen below means we never saw the corresponding Param.
+	 */
+	prunestate->nexecparams = nexecparams;
+	foreach(lc, pruneinfo->prune_infos)
+	{
+		List	   *partrelpruneinfos = lfirst_node(List, lc);
+		ListCell   *lc2;
+
+		foreach(lc2, partrelpruneinfos)
+		{
+			PartitionedRelPruneInfo *pinfo =
+			lfirst_node(PartitionedRelPruneInfo, lc2);
+			ListCell   *lc3;
+
+			foreach(lc3, pinfo->exec_pruning_steps)
+			{
+				PartitionPruneStepOp *step =
+				(PartitionPruneStepOp *) lfirst(lc3);
+
+				if (IsA(step, PartitionPruneStepOp))
+					(void) expression_tree_walker((Node *) step->exprs,
+												  prune_param_types_walker,
+												  (void *) prunestate);
+			}
+		}
+	}
+
+	for (i = 0; i < nexecparams; i++)
+	{
+		if (prunestate->cachetyplens[i] == 0)
+		{
+			/* couldn't determine this parameter's type; disable caching */
+			prunestate->nexecparams = 0;
+			return;
+		}
+	}
+}
+
+/*
+ * Walker for InitPruneResultCache: record the type length and by-value-ness
+ * of each PARAM_EXEC Param that belongs to the prunestate's execparamids.
+ */
+static bool
+prune_param_types_walker(Node *node, PartitionPruneState *prunestate)
+{
+	if (node == NULL)
+		return false;
+	if (IsA(node, Param))
+	{
+		Param	   *param = (Param *) node;
+
+		if (param->paramkind == PARAM_EXEC)
+		{
+			int			idx = bms_member_index(prunestate->execparamids,
+											   param->paramid);
+
+			if (idx >= 0)
+				get_typlenbyval(param->paramtype,
+								&prunestate->cachetyplens[idx],
+								&prunestate->cachetypbyvals[idx]);
+		}
+		return false;
+	}
+	return expression_tree_walker(node, prune_param_types_walker,
+								  (void *) prunestate);
+}
+
+/*
+ * LookupPruneResultCache
+ *		If we have a cached pruning result and the values of the relevant
+ *		PARAM_EXEC parameters are unchanged since it was computed, set
+ *		*result to a copy of it (in the current memory context) and return
+ *		true.
+ */
+static bool
+LookupPruneResultCache(PartitionPruneState *prunestate, Bitmapset **result)
+{
+	ParamExecData *paramvals;
+	int			i;
+
+	if (!prunestate->cachevalid)
+		return false;
+
+	paramvals = prunestate->econtext->ecxt_param_exec_vals;
+	for (i = 0; i < prunestate->nexecparams; i++)
+	{
+		ParamExecData *prm = &paramvals[prunestate->cacheparamids[i]];
+
+		/* can't use the cache if the parameter isn't evaluated yet */
+		if (prm->execPlan != NULL)
+			return false;
+		if (prm->isnull != prunestate->cacheisnulls[i])
+			return false;
+		if (!prm->isnull &&
+			!datumIsEqual(prm->value, prunestate->cachevalues[i],
+						  prunestate->cachetypbyvals[i],
+						  prunestate->cachetyplens[i]))
+			return false;
+	}
+
+	*result = bms_copy(prunestate->cacheresult);
+	return true;
+}
+
+/*
+ * SavePruneResultCache
+ *		Remember the given pruning result, keyed on the current values of
+ *		the relevant PARAM_EXEC parameters.
+ */
+static void
+SavePruneResultCache(PartitionPruneState *prunestate, Bitmapset *result)
+{
+	ParamExecData *paramvals;
+	MemoryContext oldcontext;
+	int			i;
+
+	if (prunestate->nexecparams == 0)
+		return;
+
+	/* Discard the previous entry, if any */
+	if (prunestate->cachevalid)
+	{
+		prunestate->cachevalid = false;
+		for (i = 0; i < prunestate->nexecparams; i++)
+		{
+			if (!prunestate->cachetypbyvals[i] &&
+				!prunestate->cacheisnulls[i])
+				pfree(DatumGetPointer(prunestate->cachevalues[i]));
+		}
+		bms_free(prunestate->cacheresult);
+		prunestate->cacheresult = NULL;
+	}
+
+	/*
+	 * If some parameter has not been evaluated (the pruning steps didn't
+	 * need its value this time), we have no key to store the result under.
+	 */
+	paramvals = prunestate->econtext->ecxt_param_exec_vals;
+	for (i = 0; i < prunestate->nexecparams; i++)
+	{
+		if (paramvals[prunestate->cacheparamids[i]].execPlan != NULL)
+			return;
+	}
+
+	oldcontext = MemoryContextSwitchTo(prunestate->cachecontext);
+	for (i = 0; i < prunestate->nexecparams; i++)
+	{
+		ParamExecData *prm = &paramvals[prunestate->cacheparamids[i]];
+
+		prunestate->cacheisnulls[i] = prm->isnull;
+		if (prm->isnull)
+			prunestate->cachevalues[i] = (Datum) 0;
+		else
+			prunestate->cachevalues[i] = datumCopy(prm->value,
+												   prunestate->cachetypbyvals[i],
+												   prunestate->cachetyplens[i]);
+	}
+	prunestate->cacheresult = bms_copy(result);
+	MemoryContextSwitchTo(oldcontext);
+	prunestate->cachevalid = true;
+}
+
 /*
  * Initialize a PartitionPruneContext for the given list of pruning steps.
  */
@@ -2286,6 +2503,15 @@ ExecFindMatchingSubPlans(PartitionPruneState *prunestate,
 	 */
 	Assert(initial_prune || prunestate->do_exec_prune);
 
+	/*
+	 * If the relevant parameter values are unchanged since the last
+	 * exec-time pruning round, reuse its result instead of re-evaluating
+	 * the pruning steps.
+	 */
+	if (!initial_prune && prunestate->nexecparams > 0 &&
+		LookupPruneResultCache(prunestate, &result))
+		return result;
+
 	/*
 	 * Switch to a temp context to avoid leaking memory in the executor's
 	 * query-lifespan memory context.
@@ -2323,6 +2549,10 @@ ExecFindMatchingSubPlans(PartitionPruneState *prunestate,
 	/* Copy result out of the temp context before we reset it */
 	result = bms_copy(result);
 
+	/* Remember the result for the next round of exec-time pruning */
+	if (!initial_prune)
+		SavePruneResultCache(prunestate, result);
+
 	MemoryContextReset(prunestate->prune_context);
 
 	return result;
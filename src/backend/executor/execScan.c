@@ -23,6 +23,13 @@
 #include "utils/memutils.h"
 
 
+static TupleTableSlot *ExecScanWithQualProject(ScanState *node,
+											   ExecScanAccessMtd accessMtd,
+											   ExecScanRecheckMtd recheckMtd,
+											   ExprState *qual,
+											   ProjectionInfo *projInfo,
+											   ExprContext *econtext);
+
 
 /*
  * ExecScanFetch -- check interrupts & fetch next potential tuple
@@ -188,6 +195,50 @@ ExecScan(ScanState *node,
 	 */
 	ResetExprContext(econtext);
 
+	return ExecScanWithQualProject(node, accessMtd, recheckMtd,
+								   qual, projInfo, econtext);
+}
+
+/*
+ * ExecScanNoQualProject
+ *		Fast-path version of ExecScan for scan nodes with neither a qual
+ *		nor a projection.
+ *
+ * Scan nodes that know at initialization time that they will never need
+ * to evaluate a qual or project can install an ExecProcNode wrapper that
+ * calls this directly, keeping the per-tuple path free of the checks that
+ * ExecScan must otherwise repeat for every tuple.
+ */
+TupleTableSlot *
+ExecScanNoQualProject(ScanState *node,
+					  ExecScanAccessMtd accessMtd,
+					  ExecScanRecheckMtd recheckMtd)
+{
+	Assert(node->ps.qual == NULL);
+	Assert(node->ps.ps_ProjInfo == NULL);
+
+	/*
+	 * Reset per-tuple memory context to free any expression evaluation
+	 * storage allocated in the previous tuple cycle.
+	 */
+	ResetExprContext(node->ps.ps_ExprContext);
+
+	return ExecScanFetch(node, accessMtd, recheckMtd);
+}
+
+/*
+ * ExecScanWithQualProject
+ *		Guts of ExecScan's qual-checking/projecting loop, split out so that
+ *		the fast path above stays branch-free.
+ */
+static TupleTableSlot *
+ExecScanWithQualProject(ScanState *node,
+						ExecScanAccessMtd accessMtd,
+						ExecScanRecheckMtd recheckMtd,
+						ExprState *qual,
+						ProjectionInfo *projInfo,
+						ExprContext *econtext)
+{
 	/*
 	 * get a tuple from the access method.  Loop until we obtain a tuple that
 	 * passes the qualification.
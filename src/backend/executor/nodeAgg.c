@@ -431,7 +431,8 @@ static void hashagg_reset_spill_state(AggState *aggstate);
 static HashAggBatch *hashagg_batch_new(LogicalTape *input_tape, int setno,
 									   int64 input_tuples, double input_card,
 									   int used_bits);
-static MinimalTuple hashagg_batch_read(HashAggBatch *batch, uint32 *hashp);
+static MinimalTuple hashagg_batch_read(AggState *aggstate, HashAggBatch *batch,
+									   uint32 *hashp);
 static void hashagg_spill_init(HashAggSpill *spill, LogicalTapeSet *lts,
 							   int used_bits, double input_groups,
 							   double hashentrysize);
@@ -2660,11 +2661,11 @@ agg_refill_hash_table(AggState *aggstate)
 
 		CHECK_FOR_INTERRUPTS();
 
-		tuple = hashagg_batch_read(batch, &hash);
+		tuple = hashagg_batch_read(aggstate, batch, &hash);
 		if (tuple == NULL)
 			break;
 
-		ExecStoreMinimalTuple(tuple, spillslot, true);
+		ExecStoreMinimalTuple(tuple, spillslot, false);
 		aggstate->tmpcontext->ecxt_outertuple = spillslot;
 
 		prepare_hash_slot(perhash,
@@ -3003,7 +3004,7 @@ hashagg_batch_new(LogicalTape *input_tape, int setno,
  * 		read the next tuple from a batch's tape.  Return NULL if no more.
  */
 static MinimalTuple
-hashagg_batch_read(HashAggBatch *batch, uint32 *hashp)
+hashagg_batch_read(AggState *aggstate, HashAggBatch *batch, uint32 *hashp)
 {
 	LogicalTape *tape = batch->input_tape;
 	MinimalTuple tuple;
@@ -3029,7 +3030,25 @@ hashagg_batch_read(HashAggBatch *batch, uint32 *hashp)
 				 errmsg("unexpected EOF for tape %p: requested %zu bytes, read %zu bytes",
 						tape, sizeof(uint32), nread)));
 
-	tuple = (MinimalTuple) palloc(t_len);
+	/*
+	 * Read the tuple into a buffer that is reused across calls, rather than
+	 * doing a palloc/pfree cycle per spilled tuple.  The caller stores the
+	 * result into hash_spill_rslot without transferring ownership, and is
+	 * done with it before the next call here.
+	 */
+	if (aggstate->hash_batch_readbuf == NULL ||
+		aggstate->hash_batch_readbuf_size < t_len)
+	{
+		uint32		newsize = Max(t_len, 1024);
+
+		if (aggstate->hash_batch_readbuf != NULL)
+			pfree(aggstate->hash_batch_readbuf);
+		aggstate->hash_batch_readbuf = (MinimalTuple)
+			MemoryContextAlloc(aggstate->ss.ps.state->es_query_cxt, newsize);
+		aggstate->hash_batch_readbuf_size = newsize;
+	}
+
+	tuple = aggstate->hash_batch_readbuf;
 	tuple->t_len = t_len;
 
 	nread = LogicalTapeRead(tape,
@@ -3586,6 +3605,8 @@ ExecInitAgg(Agg *node, EState *estate, int eflags)
 															&TTSOpsMinimalTuple);
 		aggstate->hash_spill_wslot = ExecInitExtraTupleSlot(estate, scanDesc,
 															&TTSOpsVirtual);
+		aggstate->hash_batch_readbuf = NULL;
+		aggstate->hash_batch_readbuf_size = 0;
 
 		/* this is an array of pointers, not structures */
 		aggstate->hash_pergroup = pergroups;
@@ -32,8 +32,15 @@
  * for efficiency when possible: this minimizes context-switching overhead.
  * But reading too many at a time wastes memory without improving performance.
  * We'll read up to MAX_TUPLE_STORE tuples (in addition to the first one).
+ *
+ * Each worker visit has a fixed cost (interrupt check, queue bookkeeping,
+ * and potentially a latch wait), so with many workers feeding a fast merge
+ * a shallow read-ahead leaves the leader paying that cost every handful of
+ * tuples.  64 tuples keeps the per-worker memory modest — an array of
+ * pointers plus the buffered tuples themselves — while visiting each
+ * worker's queue an order of magnitude less often.
  */
-#define MAX_TUPLE_STORE 10
+#define MAX_TUPLE_STORE 64
 
 /*
  * Pending-tuple array for each worker.  This holds additional tuples that
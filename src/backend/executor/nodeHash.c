@@ -174,6 +174,17 @@ MultiExecPrivateHash(HashState *node)
 		{
 			int			bucketNumber;
 
+			/*
+			 * Remember the hash value in the Bloom filter, if we're keeping
+			 * one.  This must happen here rather than in
+			 * ExecHashTableInsert, so that tuples reloaded from batch files
+			 * aren't added a second time and skew tuples aren't missed.
+			 */
+			if (hashtable->bloomFilter)
+				bloom_add_element(hashtable->bloomFilter,
+								  (unsigned char *) &hashvalue,
+								  sizeof(uint32));
+
 			bucketNumber = ExecHashGetSkewBucket(hashtable, hashvalue);
 			if (bucketNumber != INVALID_SKEW_BUCKET_NO)
 			{
@@ -497,6 +508,7 @@ ExecHashTableCreate(HashState *state, List *hashOperators, List *hashCollations,
 	hashtable->nbatch_original = nbatch;
 	hashtable->nbatch_outstart = nbatch;
 	hashtable->growEnabled = true;
+	hashtable->bloomFilter = NULL;
 	hashtable->totalTuples = 0;
 	hashtable->partialTuples = 0;
 	hashtable->skewTuples = 0;
@@ -572,6 +584,21 @@ ExecHashTableCreate(HashState *state, List *hashOperators, List *hashCollations,
 		/* The files will not be opened until needed... */
 		/* ... but make sure we have temp tablespaces established for them */
 		PrepareTempTablespaces();
+
+		/*
+		 * Multi-batch joins also get a Bloom filter over the hash values of
+		 * the entire inner relation.  Outer tuples whose hash value is
+		 * absent from the filter cannot match in any batch, so they can be
+		 * emitted or discarded immediately instead of being written out to a
+		 * batch file and probed later.  bloom_create never sizes the bitset
+		 * below 1MB, which is why we don't bother for single-batch joins:
+		 * there the filter could cost more memory than the hash table it is
+		 * guarding.
+		 */
+		hashtable->bloomFilter =
+			bloom_create((int64) Max(rows, 1.0),
+						 (int) Min(space_allowed / 1024, (size_t) INT_MAX),
+						 0);
 	}
 
 	MemoryContextSwitchTo(oldcxt);
@@ -1965,6 +1992,12 @@ ExecScanHashBucket(HashJoinState *hjstate,
 
 	while (hashTuple != NULL)
 	{
+		/*
+		 * Hide some of the memory latency of chasing the bucket chain by
+		 * requesting the next tuple's cache line before examining this one.
+		 */
+		pg_prefetch_mem(hashTuple->next.unshared);
+
 		if (hashTuple->hashvalue == hashvalue)
 		{
 			TupleTableSlot *inntuple;
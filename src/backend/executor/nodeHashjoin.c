@@ -379,10 +379,36 @@ ExecHashJoinImpl(PlanState *pstate, bool parallel)
 				node->hj_CurHashValue = hashvalue;
 				ExecHashGetBucketAndBatch(hashtable, hashvalue,
 										  &node->hj_CurBucketNo, &batchno);
+
+				/*
+				 * For large hash tables, reading the bucket header below is
+				 * usually a cache miss.  Start fetching it now, while we're
+				 * busy with the skew, Bloom filter and batch-number checks.
+				 */
+				if (!parallel && batchno == hashtable->curbatch)
+					pg_prefetch_mem(&hashtable->buckets.unshared[node->hj_CurBucketNo]);
+
 				node->hj_CurSkewBucketNo = ExecHashGetSkewBucket(hashtable,
 																 hashvalue);
 				node->hj_CurTuple = NULL;
 
+				/*
+				 * If a Bloom filter was built over the inner relation, test
+				 * this tuple's hash value against it.  A negative answer
+				 * means there is no match in any batch or skew bucket, so we
+				 * can proceed directly to the outer-fill logic without
+				 * probing the hash table or saving the tuple to a batch
+				 * file.
+				 */
+				if (hashtable->bloomFilter &&
+					bloom_lacks_element(hashtable->bloomFilter,
+										(unsigned char *) &hashvalue,
+										sizeof(uint32)))
+				{
+					node->hj_JoinState = HJ_FILL_OUTER_TUPLE;
+					continue;
+				}
+
 				/*
 				 * The tuple might not belong to the current batch (where
 				 * "current batch" includes the skew buckets if any).
@@ -71,6 +71,7 @@
 #include "executor/nodeMemoize.h"
 #include "lib/ilist.h"
 #include "miscadmin.h"
+#include "nodes/makefuncs.h"
 #include "utils/datum.h"
 #include "utils/lsyscache.h"
 
@@ -276,7 +277,7 @@ build_hash_table(MemoizeState *mstate, uint32 size)
  * prepare_probe_slot
  *		Populate mstate's probeslot with the values from the tuple stored
  *		in 'key'.  If 'key' is NULL, then perform the population by evaluating
- *		mstate's param_exprs.
+ *		mstate's cache key projection.
  */
 static inline void
 prepare_probe_slot(MemoizeState *mstate, MemoizeKey *key)
@@ -285,26 +286,26 @@ prepare_probe_slot(MemoizeState *mstate, MemoizeKey *key)
 	TupleTableSlot *tslot = mstate->tableslot;
 	int			numKeys = mstate->nkeys;
 
-	ExecClearTuple(pslot);
-
 	if (key == NULL)
 	{
-		/* Set the probeslot's values based on the current parameter values */
-		for (int i = 0; i < numKeys; i++)
-			pslot->tts_values[i] = ExecEvalExpr(mstate->param_exprs[i],
-												mstate->ss.ps.ps_ExprContext,
-												&pslot->tts_isnull[i]);
+		/*
+		 * Evaluate the expressions for all cache keys in one go, storing the
+		 * results directly into the probeslot.  This is cheaper than calling
+		 * into ExecEvalExpr once per key.
+		 */
+		ExecProject(mstate->cache_keys_proj);
 	}
 	else
 	{
 		/* Process the key's MinimalTuple and store the values in probeslot */
+		ExecClearTuple(pslot);
 		ExecStoreMinimalTuple(key->params, tslot, false);
 		slot_getallattrs(tslot);
 		memcpy(pslot->tts_values, tslot->tts_values, sizeof(Datum) * numKeys);
 		memcpy(pslot->tts_isnull, tslot->tts_isnull, sizeof(bool) * numKeys);
-	}
 
-	ExecStoreVirtualTuple(pslot);
+		ExecStoreVirtualTuple(pslot);
+	}
 }
 
 /*
@@ -914,6 +915,7 @@ ExecInitMemoize(Memoize *node, EState *estate, int eflags)
 	int			i;
 	int			nkeys;
 	Oid		   *eqfuncoids;
+	List	   *keytlist;
 
 	/* check for unsupported flags */
 	Assert(!(eflags & (EXEC_FLAG_BACKWARD | EXEC_FLAG_MARK)));
@@ -958,12 +960,12 @@ ExecInitMemoize(Memoize *node, EState *estate, int eflags)
 	mstate->probeslot = MakeSingleTupleTableSlot(mstate->hashkeydesc,
 												 &TTSOpsVirtual);
 
-	mstate->param_exprs = (ExprState **) palloc(nkeys * sizeof(ExprState *));
 	mstate->collations = node->collations;	/* Just point directly to the plan
 											 * data */
 	mstate->hashfunctions = (FmgrInfo *) palloc(nkeys * sizeof(FmgrInfo));
 
 	eqfuncoids = palloc(nkeys * sizeof(Oid));
+	keytlist = NIL;
 
 	for (i = 0; i < nkeys; i++)
 	{
@@ -978,10 +980,23 @@ ExecInitMemoize(Memoize *node, EState *estate, int eflags)
 
 		fmgr_info(left_hashfn, &mstate->hashfunctions[i]);
 
-		mstate->param_exprs[i] = ExecInitExpr(param_expr, (PlanState *) mstate);
+		keytlist = lappend(keytlist,
+						   makeTargetEntry(param_expr, i + 1, NULL, false));
 		eqfuncoids[i] = get_opcode(hashop);
 	}
 
+	/*
+	 * Build a projection which evaluates all of the cache key expressions at
+	 * once and stores the results into the probeslot.  This means cache
+	 * lookups need just a single trip through expression evaluation rather
+	 * than one per key.
+	 */
+	mstate->cache_keys_proj = ExecBuildProjectionInfo(keytlist,
+													  mstate->ss.ps.ps_ExprContext,
+													  mstate->probeslot,
+													  (PlanState *) mstate,
+													  NULL);
+
 	mstate->cache_eq_expr = ExecBuildParamSetEqual(mstate->hashkeydesc,
 												   &TTSOpsMinimalTuple,
 												   &TTSOpsVirtual,
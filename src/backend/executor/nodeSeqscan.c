@@ -114,6 +114,24 @@ ExecSeqScan(PlanState *pstate)
 					(ExecScanRecheckMtd) SeqRecheck);
 }
 
+/* ----------------------------------------------------------------
+ *		ExecSeqScanNoQualProject(node)
+ *
+ *		Variant of ExecSeqScan installed when the node has neither a qual
+ *		nor a projection, so that the per-tuple loop can skip ExecScan's
+ *		checks for them entirely.
+ * ----------------------------------------------------------------
+ */
+static TupleTableSlot *
+ExecSeqScanNoQualProject(PlanState *pstate)
+{
+	SeqScanState *node = castNode(SeqScanState, pstate);
+
+	return ExecScanNoQualProject(&node->ss,
+								 (ExecScanAccessMtd) SeqNext,
+								 (ExecScanRecheckMtd) SeqRecheck);
+}
+
 
 /* ----------------------------------------------------------------
  *		ExecInitSeqScan
@@ -171,6 +189,13 @@ ExecInitSeqScan(SeqScan *node, EState *estate, int eflags)
 	scanstate->ss.ps.qual =
 		ExecInitQual(node->scan.plan.qual, (PlanState *) scanstate);
 
+	/*
+	 * Now that we know whether a qual or projection is needed, switch to the
+	 * fast-path ExecProcNode routine if neither is.
+	 */
+	if (scanstate->ss.ps.qual == NULL && scanstate->ss.ps.ps_ProjInfo == NULL)
+		scanstate->ss.ps.ExecProcNode = ExecSeqScanNoQualProject;
+
 	return scanstate;
 }
 
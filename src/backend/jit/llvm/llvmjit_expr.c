@@ -64,6 +64,12 @@ static LLVMValueRef build_EvalXFuncInt(LLVMBuilderRef b, LLVMModuleRef mod,
 									   int natts, LLVMValueRef *v_args);
 static LLVMValueRef create_LifetimeEnd(LLVMModuleRef mod);
 
+/*
+ * Expressions with this many steps or fewer are left to the interpreter;
+ * see llvm_compile_expr.
+ */
+#define MIN_STEPS_TO_COMPILE	3
+
 /* macro making it easier to call ExecEval* functions */
 #define build_EvalXFunc(b, mod, funcname, v_state, op, ...) \
 	build_EvalXFuncInt(b, mod, funcname, v_state, op, \
@@ -123,6 +129,16 @@ llvm_compile_expr(ExprState *state)
 	instr_time	starttime;
 	instr_time	endtime;
 
+	/*
+	 * Don't bother compiling trivial expressions.  The fixed overhead of
+	 * emitting, optimizing and linking a module cannot pay for itself when
+	 * there are only a handful of steps to run, no matter how often the
+	 * expression is executed.  The threshold is deliberately conservative:
+	 * three steps is just a slot fetch, one leaf evaluation and EEOP_DONE.
+	 */
+	if (state->steps_len <= MIN_STEPS_TO_COMPILE)
+		return false;
+
 	llvm_enter_fatal_on_oom();
 
 	/*
@@ -146,6 +146,7 @@ static int	socket_putmessage(char msgtype, const char *s, size_t len);
 static void socket_putmessage_noblock(char msgtype, const char *s, size_t len);
 static int	internal_putbytes(const char *s, size_t len);
 static int	internal_flush(void);
+static int	internal_flush_buffer(const char *buf, size_t *start, size_t *end);
 
 static int	Lock_AF_UNIX(const char *unixSocketDir, const char *unixSocketPath);
 static int	Setup_AF_UNIX(const char *sock_path);
@@ -1286,6 +1287,25 @@ internal_putbytes(const char *s, size_t len)
 			if (internal_flush())
 				return EOF;
 		}
+
+		/*
+		 * If the data is larger than the send buffer and nothing is queued
+		 * ahead of it, send it directly from the caller's memory rather than
+		 * paying for an extra memcpy into PqSendBuffer.  COPY TO in
+		 * particular can produce messages much larger than the buffer.
+		 */
+		if (len >= (size_t) PqSendBufferSize &&
+			PqSendStart == PqSendPointer)
+		{
+			size_t		start = 0;
+			size_t		end = len;
+
+			socket_set_nonblocking(false);
+			if (internal_flush_buffer(s, &start, &end))
+				return EOF;
+			return 0;
+		}
+
 		amount = PqSendBufferSize - PqSendPointer;
 		if (amount > len)
 			amount = len;
@@ -1327,17 +1347,43 @@ socket_flush(void)
  */
 static int
 internal_flush(void)
+{
+	size_t		start = PqSendStart;
+	size_t		end = PqSendPointer;
+	int			res;
+
+	res = internal_flush_buffer(PqSendBuffer, &start, &end);
+	PqSendStart = start;
+	PqSendPointer = end;
+	return res;
+}
+
+/* --------------------------------
+ *		internal_flush_buffer - flush the given range of the given buffer
+ *
+ * This is the workhorse for internal_flush, and is also used directly by
+ * internal_putbytes for data too large to be worth copying into
+ * PqSendBuffer.  *start and *end are updated to reflect how much was sent,
+ * following the same conventions as PqSendStart and PqSendPointer.
+ *
+ * Returns 0 if OK (meaning everything was sent, or operation would block
+ * and the socket is in non-blocking mode), or EOF if trouble.
+ * --------------------------------
+ */
+static int
+internal_flush_buffer(const char *buf, size_t *start, size_t *end)
 {
 	static int	last_reported_send_errno = 0;
 
-	char	   *bufptr = PqSendBuffer + PqSendStart;
-	char	   *bufend = PqSendBuffer + PqSendPointer;
+	const char *bufptr = buf + *start;
+	const char *bufend = buf + *end;
 
 	while (bufptr < bufend)
 	{
 		int			r;
 
-		r = secure_write(MyProcPort, bufptr, bufend - bufptr);
+		r = secure_write(MyProcPort, unconstify(char *, bufptr),
+						 bufend - bufptr);
 
 		if (r <= 0)
 		{
@@ -1377,7 +1423,7 @@ internal_flush(void)
 			 * flag that'll cause the next CHECK_FOR_INTERRUPTS to terminate
 			 * the connection.
 			 */
-			PqSendStart = PqSendPointer = 0;
+			*start = *end = 0;
 			ClientConnectionLost = 1;
 			InterruptPending = 1;
 			return EOF;
@@ -1385,10 +1431,10 @@ internal_flush(void)
 
 		last_reported_send_errno = 0;	/* reset after any successful send */
 		bufptr += r;
-		PqSendStart += r;
+		*start += r;
 	}
 
-	PqSendStart = PqSendPointer = 0;
+	*start = *end = 0;
 	return 0;
 }
 
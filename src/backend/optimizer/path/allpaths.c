@@ -1752,18 +1752,11 @@ generate_orderedappend_paths(PlannerInfo *root, RelOptInfo *rel,
 					   *cheapest_fractional = NULL;
 
 			/* Locate the right paths, if they are available. */
-			cheapest_startup =
-				get_cheapest_path_for_pathkeys(childrel->pathlist,
-											   pathkeys,
-											   NULL,
-											   STARTUP_COST,
-											   false);
-			cheapest_total =
-				get_cheapest_path_for_pathkeys(childrel->pathlist,
-											   pathkeys,
-											   NULL,
-											   TOTAL_COST,
-											   false);
+			get_cheapest_paths_for_pathkeys(childrel->pathlist,
+											pathkeys,
+											NULL,
+											&cheapest_startup,
+											&cheapest_total);
 
 			/*
 			 * If we can't find any paths with the right order just use the
@@ -31,6 +31,7 @@ static void make_rels_by_clauseless_joins(PlannerInfo *root,
 										  RelOptInfo *old_rel,
 										  List *other_rels);
 static bool has_join_restriction(PlannerInfo *root, RelOptInfo *rel);
+static bool calc_join_restriction(PlannerInfo *root, RelOptInfo *rel);
 static bool has_legal_joinclause(PlannerInfo *root, RelOptInfo *rel);
 static bool restriction_is_constant_false(List *restrictlist,
 										  RelOptInfo *joinrel,
@@ -1062,6 +1063,27 @@ have_join_order_restriction(PlannerInfo *root,
  */
 static bool
 has_join_restriction(PlannerInfo *root, RelOptInfo *rel)
+{
+	/*
+	 * The answer depends only on the rel's identity and planner state that
+	 * is fixed before the join search begins, but we get asked about the
+	 * same rel once per join search level; cache the result in the
+	 * RelOptInfo.
+	 */
+	if (!rel->has_join_restr_valid)
+	{
+		rel->has_join_restr = calc_join_restriction(root, rel);
+		rel->has_join_restr_valid = true;
+	}
+	return rel->has_join_restr;
+}
+
+/*
+ * calc_join_restriction
+ *		Workhorse for has_join_restriction; computes the uncached answer.
+ */
+static bool
+calc_join_restriction(PlannerInfo *root, RelOptInfo *rel)
 {
 	ListCell   *l;
 
@@ -991,6 +991,54 @@ get_cheapest_path_for_pathkeys(List *paths, List *pathkeys,
 	return matched_path;
 }
 
+/*
+ * get_cheapest_paths_for_pathkeys
+ *	  Find both the cheapest-startup and the cheapest-total path that
+ *	  satisfy the given pathkeys and parameterization, making just one
+ *	  pass over the path list.  *startup_path and *total_path are set to
+ *	  NULL if there is no suitable path.
+ *
+ * This gives the same answers as two get_cheapest_path_for_pathkeys calls
+ * with STARTUP_COST and TOTAL_COST, but checks each path's pathkeys and
+ * parameterization only once.  Callers that want both paths, such as
+ * generate_orderedappend_paths, may repeat this for every child of a
+ * partitioned table, so the savings add up.
+ */
+void
+get_cheapest_paths_for_pathkeys(List *paths, List *pathkeys,
+								Relids required_outer,
+								Path **startup_path, Path **total_path)
+{
+	Path	   *startup = NULL;
+	Path	   *total = NULL;
+	ListCell   *l;
+
+	foreach(l, paths)
+	{
+		Path	   *path = (Path *) lfirst(l);
+
+		/* No interest in paths that win on neither criterion */
+		if (startup != NULL &&
+			compare_path_costs(startup, path, STARTUP_COST) <= 0 &&
+			compare_path_costs(total, path, TOTAL_COST) <= 0)
+			continue;
+
+		if (!pathkeys_contained_in(pathkeys, path->pathkeys) ||
+			!bms_is_subset(PATH_REQ_OUTER(path), required_outer))
+			continue;
+
+		if (startup == NULL ||
+			compare_path_costs(path, startup, STARTUP_COST) < 0)
+			startup = path;
+		if (total == NULL ||
+			compare_path_costs(path, total, TOTAL_COST) < 0)
+			total = path;
+	}
+
+	*startup_path = startup;
+	*total_path = total;
+}
+
 /*
  * get_cheapest_fractional_path_for_pathkeys
  *	  Find the cheapest path (for retrieving a specified fraction of all
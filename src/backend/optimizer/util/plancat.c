@@ -1085,9 +1085,22 @@ int32
 get_rel_data_width(Relation rel, int32 *attr_widths)
 {
 	int32		tuple_width = 0;
+	int			natts = RelationGetNumberOfAttributes(rel);
+	int32	   *stat_widths = NULL;
 	int			i;
 
-	for (i = 1; i <= RelationGetNumberOfAttributes(rel); i++)
+	/*
+	 * Unless a get_attavgwidth hook is installed (in which case it must see
+	 * each per-column request), fetch the relation's pg_statistic widths in
+	 * one batched lookup rather than probing the syscache once per column.
+	 */
+	if (get_attavgwidth_hook == NULL && natts > 0)
+	{
+		stat_widths = (int32 *) palloc((natts + 1) * sizeof(int32));
+		get_rel_attavgwidths(RelationGetRelid(rel), natts, stat_widths);
+	}
+
+	for (i = 1; i <= natts; i++)
 	{
 		Form_pg_attribute att = TupleDescAttr(rel->rd_att, i - 1);
 		int32		item_width;
@@ -1103,7 +1116,10 @@ get_rel_data_width(Relation rel, int32 *attr_widths)
 		}
 
 		/* This should match set_rel_width() in costsize.c */
-		item_width = get_attavgwidth(RelationGetRelid(rel), i);
+		if (stat_widths != NULL)
+			item_width = stat_widths[i];
+		else
+			item_width = get_attavgwidth(RelationGetRelid(rel), i);
 		if (item_width <= 0)
 		{
 			item_width = get_typavgwidth(att->atttypid, att->atttypmod);
@@ -1114,6 +1130,9 @@ get_rel_data_width(Relation rel, int32 *attr_widths)
 		tuple_width += item_width;
 	}
 
+	if (stat_widths != NULL)
+		pfree(stat_widths);
+
 	return tuple_width;
 }
 
@@ -217,6 +217,12 @@ int			ReservedBackends;
 
 /* The socket(s) we're listening to. */
 #define MAXLISTEN	64
+
+/*
+ * How many connections ServerLoop may accept from one listen socket per
+ * wakeup before it must return to its regular duties.
+ */
+#define MAX_ACCEPTS_PER_WAKEUP	64
 static pgsocket ListenSocket[MAXLISTEN];
 
 /*
@@ -410,6 +416,7 @@ static int	ProcessStartupPacket(Port *port, bool ssl_done, bool gss_done);
 static void SendNegotiateProtocolVersion(List *unrecognized_protocol_options);
 static void processCancelRequest(Port *port, void *pkt);
 static int	initMasks(fd_set *rmask);
+static bool ListenSocketHasPending(pgsocket sock);
 static void report_fork_failure_to_client(Port *port, int errnum);
 static CAC_state canAcceptConnections(int backend_type);
 static bool RandomCancelKey(int32 *cancel_key);
@@ -1792,9 +1799,22 @@ ServerLoop(void)
 
 			for (i = 0; i < MAXLISTEN; i++)
 			{
+				int			naccepted = 0;
+
 				if (ListenSocket[i] == PGINVALID_SOCKET)
 					break;
-				if (FD_ISSET(ListenSocket[i], &rmask))
+				if (!FD_ISSET(ListenSocket[i], &rmask))
+					continue;
+
+				/*
+				 * Drain a burst of connection requests on this socket before
+				 * going back to the top of the loop, so that each accepted
+				 * connection doesn't cost a full iteration with its two
+				 * signal mask switches and select() over all sockets.  Cap
+				 * the number accepted per wakeup so a sustained storm can't
+				 * starve the postmaster's other duties.
+				 */
+				do
 				{
 					Port	   *port;
 
@@ -1810,7 +1830,10 @@ ServerLoop(void)
 						StreamClose(port->sock);
 						ConnFree(port);
 					}
-				}
+					else
+						break;
+				} while (++naccepted < MAX_ACCEPTS_PER_WAKEUP &&
+						 ListenSocketHasPending(ListenSocket[i]));
 			}
 		}
 
@@ -1976,6 +1999,22 @@ initMasks(fd_set *rmask)
 	return maxsock + 1;
 }
 
+/*
+ * Check whether a listen socket has another connection request waiting,
+ * without blocking.
+ */
+static bool
+ListenSocketHasPending(pgsocket sock)
+{
+	fd_set		rmask;
+	struct timeval timeout = {0, 0};
+
+	FD_ZERO(&rmask);
+	FD_SET(sock, &rmask);
+
+	return select(sock + 1, &rmask, NULL, NULL, &timeout) > 0;
+}
+
 
 /*
  * Read a client's startup packet and do something according to it.
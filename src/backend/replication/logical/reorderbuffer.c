@@ -209,6 +209,13 @@ typedef struct ReorderBufferDiskChange
 int			logical_decoding_work_mem;
 static const Size max_changes_in_memory = 4096; /* XXX for restore only */
 
+/*
+ * Size of the buffer used to batch writes when spilling changes to disk.
+ * Large enough to amortize the per-write syscall cost over many typical
+ * changes, small enough not to matter next to logical_decoding_work_mem.
+ */
+static const Size spill_buffer_size = 64 * 1024;
+
 /* ---------------------------------------
  * primary reorderbuffer support routines
  * ---------------------------------------
@@ -246,7 +253,12 @@ static void ReorderBufferExecuteInvalidations(uint32 nmsgs, SharedInvalidationMe
 static void ReorderBufferCheckMemoryLimit(ReorderBuffer *rb);
 static void ReorderBufferSerializeTXN(ReorderBuffer *rb, ReorderBufferTXN *txn);
 static void ReorderBufferSerializeChange(ReorderBuffer *rb, ReorderBufferTXN *txn,
-										 int fd, ReorderBufferChange *change);
+										 int fd, ReorderBufferChange *change,
+										 char *buffer, Size *buffer_used);
+static void ReorderBufferSerializeWrite(ReorderBufferTXN *txn, int fd,
+										const char *data, Size size);
+static void ReorderBufferSerializeFlush(ReorderBufferTXN *txn, int fd,
+										char *buffer, Size *buffer_used);
 static Size ReorderBufferRestoreChanges(ReorderBuffer *rb, ReorderBufferTXN *txn,
 										TXNEntryFile *file, XLogSegNo *segno);
 static void ReorderBufferRestoreChange(ReorderBuffer *rb, ReorderBufferTXN *txn,
@@ -3591,6 +3603,8 @@ ReorderBufferSerializeTXN(ReorderBuffer *rb, ReorderBufferTXN *txn)
 	XLogSegNo	curOpenSegNo = 0;
 	Size		spilled = 0;
 	Size		size = txn->size;
+	char	   *buffer;
+	Size		buffer_used = 0;
 
 	elog(DEBUG2, "spill %u changes in XID %u to disk",
 		 (uint32) txn->nentries_mem, txn->xid);
@@ -3604,6 +3618,12 @@ ReorderBufferSerializeTXN(ReorderBuffer *rb, ReorderBufferTXN *txn)
 		ReorderBufferSerializeTXN(rb, subtxn);
 	}
 
+	/*
+	 * Batch writes to the spill file; issuing one write syscall per change
+	 * shows up prominently when large transactions spill.
+	 */
+	buffer = palloc(spill_buffer_size);
+
 	/* serialize changestream */
 	dlist_foreach_modify(change_i, &txn->changes)
 	{
@@ -3621,7 +3641,10 @@ ReorderBufferSerializeTXN(ReorderBuffer *rb, ReorderBufferTXN *txn)
 			char		path[MAXPGPATH];
 
 			if (fd != -1)
+			{
+				ReorderBufferSerializeFlush(txn, fd, buffer, &buffer_used);
 				CloseTransientFile(fd);
+			}
 
 			XLByteToSeg(change->lsn, curOpenSegNo, wal_segment_size);
 
@@ -3642,7 +3665,8 @@ ReorderBufferSerializeTXN(ReorderBuffer *rb, ReorderBufferTXN *txn)
 						 errmsg("could not open file \"%s\": %m", path)));
 		}
 
-		ReorderBufferSerializeChange(rb, txn, fd, change);
+		ReorderBufferSerializeChange(rb, txn, fd, change,
+									 buffer, &buffer_used);
 		dlist_delete(&change->node);
 		ReorderBufferReturnChange(rb, change, true);
 
@@ -3668,15 +3692,25 @@ ReorderBufferSerializeTXN(ReorderBuffer *rb, ReorderBufferTXN *txn)
 	txn->txn_flags |= RBTXN_IS_SERIALIZED;
 
 	if (fd != -1)
+	{
+		ReorderBufferSerializeFlush(txn, fd, buffer, &buffer_used);
 		CloseTransientFile(fd);
+	}
+
+	pfree(buffer);
 }
 
 /*
  * Serialize individual change to disk.
+ *
+ * The serialized change is appended to 'buffer' (with 'buffer_used' bytes
+ * already in use), and only written out once the buffer fills up, so callers
+ * must flush before closing 'fd'.
  */
 static void
 ReorderBufferSerializeChange(ReorderBuffer *rb, ReorderBufferTXN *txn,
-							 int fd, ReorderBufferChange *change)
+							 int fd, ReorderBufferChange *change,
+							 char *buffer, Size *buffer_used)
 {
 	ReorderBufferDiskChange *ondisk;
 	Size		sz = sizeof(ReorderBufferDiskChange);
@@ -3857,9 +3891,43 @@ ReorderBufferSerializeChange(ReorderBuffer *rb, ReorderBufferTXN *txn,
 
 	ondisk->size = sz;
 
+	/* flush if the new change wouldn't fit into the remaining buffer space */
+	if (*buffer_used + ondisk->size > spill_buffer_size)
+		ReorderBufferSerializeFlush(txn, fd, buffer, buffer_used);
+
+	/* changes too large for the buffer are written out directly */
+	if (ondisk->size > spill_buffer_size)
+		ReorderBufferSerializeWrite(txn, fd, rb->outbuf, ondisk->size);
+	else
+	{
+		memcpy(buffer + *buffer_used, rb->outbuf, ondisk->size);
+		*buffer_used += ondisk->size;
+	}
+
+	/*
+	 * Keep the transaction's final_lsn up to date with each change we send to
+	 * disk, so that ReorderBufferRestoreCleanup works correctly.  (We used to
+	 * only do this on commit and abort records, but that doesn't work if a
+	 * system crash leaves a transaction without its abort record).
+	 *
+	 * Make sure not to move it backwards.
+	 */
+	if (txn->final_lsn < change->lsn)
+		txn->final_lsn = change->lsn;
+
+	Assert(ondisk->change.action == change->action);
+}
+
+/*
+ * Write a chunk of serialized changes to a spill file.
+ */
+static void
+ReorderBufferSerializeWrite(ReorderBufferTXN *txn, int fd,
+							const char *data, Size size)
+{
 	errno = 0;
 	pgstat_report_wait_start(WAIT_EVENT_REORDER_BUFFER_WRITE);
-	if (write(fd, rb->outbuf, ondisk->size) != ondisk->size)
+	if (write(fd, data, size) != size)
 	{
 		int			save_errno = errno;
 
@@ -3873,19 +3941,20 @@ ReorderBufferSerializeChange(ReorderBuffer *rb, ReorderBufferTXN *txn,
 						txn->xid)));
 	}
 	pgstat_report_wait_end();
+}
 
-	/*
-	 * Keep the transaction's final_lsn up to date with each change we send to
-	 * disk, so that ReorderBufferRestoreCleanup works correctly.  (We used to
-	 * only do this on commit and abort records, but that doesn't work if a
-	 * system crash leaves a transaction without its abort record).
-	 *
-	 * Make sure not to move it backwards.
-	 */
-	if (txn->final_lsn < change->lsn)
-		txn->final_lsn = change->lsn;
+/*
+ * Write out any changes batched up in the spill write buffer.
+ */
+static void
+ReorderBufferSerializeFlush(ReorderBufferTXN *txn, int fd,
+							char *buffer, Size *buffer_used)
+{
+	if (*buffer_used == 0)
+		return;
 
-	Assert(ondisk->change.action == change->action);
+	ReorderBufferSerializeWrite(txn, fd, buffer, *buffer_used);
+	*buffer_used = 0;
 }
 
 /* Returns true, if the output plugin supports streaming, false, otherwise. */
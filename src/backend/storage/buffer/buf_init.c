@@ -14,10 +14,22 @@
  */
 #include "postgres.h"
 
+#ifdef USE_LIBNUMA
+#include <numa.h>
+#endif
+
 #include "storage/buf_internals.h"
 #include "storage/bufmgr.h"
 #include "storage/proc.h"
 
+/*
+ * GUC: if true, spread the buffer pool's data pages across all NUMA nodes
+ * with an interleaved allocation policy, instead of leaving placement to
+ * the kernel's first-touch default (which tends to concentrate the pool on
+ * the node that first faults it in).
+ */
+bool		numa_buffers_interleave = false;
+
 BufferDescPadded *BufferDescriptors;
 char	   *BufferBlocks;
 ConditionVariableMinimallyPadded *BufferIOCVArray;
@@ -78,9 +90,12 @@ InitBufferPool(void)
 						NBuffers * sizeof(BufferDescPadded),
 						&foundDescs);
 
+	/* Align buffer pool on IO page size boundary. */
 	BufferBlocks = (char *)
-		ShmemInitStruct("Buffer Blocks",
-						NBuffers * (Size) BLCKSZ, &foundBufs);
+		TYPEALIGN(PG_IO_ALIGN_SIZE,
+				  ShmemInitStruct("Buffer Blocks",
+								  NBuffers * (Size) BLCKSZ + PG_IO_ALIGN_SIZE,
+								  &foundBufs));
 
 	/* Align condition variables to cacheline boundary. */
 	BufferIOCVArray = (ConditionVariableMinimallyPadded *)
@@ -109,6 +124,28 @@ InitBufferPool(void)
 	{
 		int			i;
 
+		/*
+		 * Apply the requested NUMA placement policy to the data pages before
+		 * anything faults them in; the descriptors and other bookkeeping
+		 * arrays are small enough that we leave them to first-touch.
+		 */
+		if (numa_buffers_interleave)
+		{
+#ifdef USE_LIBNUMA
+			if (numa_available() < 0)
+				ereport(WARNING,
+						(errmsg("NUMA is not available on this system, ignoring numa_buffers_interleave")));
+			else
+				numa_interleave_memory(BufferBlocks,
+									   NBuffers * (Size) BLCKSZ,
+									   numa_all_nodes_ptr);
+#else
+			ereport(ERROR,
+					(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+					 errmsg("NUMA support is not available in this build")));
+#endif
+		}
+
 		/*
 		 * Initialize all the buffer headers.
 		 */
@@ -163,7 +200,8 @@ BufferShmemSize(void)
 	/* to allow aligning buffer descriptors */
 	size = add_size(size, PG_CACHE_LINE_SIZE);
 
-	/* size of data pages */
+	/* size of data pages, plus alignment padding */
+	size = add_size(size, PG_IO_ALIGN_SIZE);
 	size = add_size(size, mul_size(NBuffers, BLCKSZ));
 
 	/* size of stuff controlled by freelist.c */
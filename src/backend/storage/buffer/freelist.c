@@ -63,6 +63,25 @@ typedef struct
 /* Pointers to shared state */
 static BufferStrategyControl *StrategyControl = NULL;
 
+/*
+ * Number of clock ticks a backend claims from nextVictimBuffer with a single
+ * fetch-add, consuming them locally before returning to the shared counter.
+ * This keeps the hot atomic from being hammered once per inspected buffer
+ * when many backends are evicting concurrently.  The batch must stay small:
+ * ticks a backend has claimed but not yet consumed are buffers the shared
+ * hand skips over, so a large value would degrade the clock's approximation
+ * of LRU.
+ */
+#define CLOCK_SWEEP_BATCH_SIZE	8
+
+/*
+ * Backend-local state for the current batch of claimed clock ticks.  The
+ * values stored here are raw (un-wrapped) nextVictimBuffer values; leftover
+ * ticks are consumed by this backend's next StrategyGetBuffer() call.
+ */
+static uint32 ClockSweepTickNext = 0;
+static uint32 ClockSweepTicksLeft = 0;
+
 /*
  * Private (non-shared) state for managing a ring of shared buffers to re-use.
  * This is currently the only kind of BufferAccessStrategy object, but someday
@@ -115,12 +134,21 @@ ClockSweepTick(void)
 	uint32		victim;
 
 	/*
-	 * Atomically move hand ahead one buffer - if there's several processes
+	 * Atomically move the hand ahead a whole batch of buffers and consume
+	 * the claimed positions one at a time - if there's several processes
 	 * doing this, this can lead to buffers being returned slightly out of
 	 * apparent order.
 	 */
-	victim =
-		pg_atomic_fetch_add_u32(&StrategyControl->nextVictimBuffer, 1);
+	if (ClockSweepTicksLeft == 0)
+	{
+		ClockSweepTickNext =
+			pg_atomic_fetch_add_u32(&StrategyControl->nextVictimBuffer,
+									CLOCK_SWEEP_BATCH_SIZE);
+		ClockSweepTicksLeft = CLOCK_SWEEP_BATCH_SIZE;
+	}
+
+	victim = ClockSweepTickNext++;
+	ClockSweepTicksLeft--;
 
 	if (victim >= NBuffers)
 	{
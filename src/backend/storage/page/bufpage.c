@@ -1520,9 +1520,15 @@ PageSetChecksumCopy(Page page, BlockNumber blkno)
 	 * call.  The point of palloc'ing here, rather than having a static char
 	 * array, is first to ensure adequate alignment for the checksumming code
 	 * and second to avoid wasting space in processes that never call this.
+	 * The copy is returned to bufmgr.c for the actual write-out, so align it
+	 * on the direct I/O boundary to keep it eligible for direct transfers
+	 * when io_direct_data is enabled.
 	 */
 	if (pageCopy == NULL)
-		pageCopy = MemoryContextAlloc(TopMemoryContext, BLCKSZ);
+		pageCopy = (char *)
+			TYPEALIGN(PG_IO_ALIGN_SIZE,
+					  MemoryContextAlloc(TopMemoryContext,
+										 BLCKSZ + PG_IO_ALIGN_SIZE));
 
 	memcpy(pageCopy, (char *) page, BLCKSZ);
 	((PageHeader) pageCopy)->pd_checksum = pg_checksum_page(pageCopy, blkno);
@@ -945,6 +945,124 @@ ParseDateTime(const char *timestr, char *workbuf, size_t buflen,
 }
 
 
+/* DecodeFixedDigits()
+ * Decode exactly ndigits ASCII digits starting at *cp, advancing *cp past
+ * them.  Returns false without moving *cp if any of the bytes is not a
+ * digit.  Helper for DecodeCanonicalTimestamp.
+ */
+static bool
+DecodeFixedDigits(const char **cp, int ndigits, int *result)
+{
+	int			val = 0;
+
+	for (int i = 0; i < ndigits; i++)
+	{
+		char		ch = (*cp)[i];
+
+		if (ch < '0' || ch > '9')
+			return false;
+		val = val * 10 + (ch - '0');
+	}
+	*cp += ndigits;
+	*result = val;
+	return true;
+}
+
+/* DecodeCanonicalTimestamp()
+ * Fast path for the canonical ISO timestamp layout
+ *
+ *		YYYY-MM-DD HH:MM:SS[.FFFFFF][{+|-}TZ]
+ *
+ * (a 'T' date/time separator is also accepted), which is both what we emit
+ * with DateStyle = ISO and the overwhelmingly common format in machine-
+ * generated data fed to COPY.  A string of this exact shape means the same
+ * thing under every DateStyle, since a leading four-digit field is always
+ * taken as a year, so we can decode it without the tokenize-and-classify
+ * work of ParseDateTime/DecodeDateTime.
+ *
+ * Returns true with *tm, *fsec and *tzp filled in (*tzp as for
+ * DecodeDateTime) if the string matches; returns false if it does not, in
+ * which case the caller must fall through to the general parser.  Anything
+ * doubtful --- out-of-range fields, excess precision, 24:00:00, leap
+ * seconds, named zones --- is punted to the general parser the same way, so
+ * that all error reports and corner-case behavior still come from one
+ * place.
+ */
+bool
+DecodeCanonicalTimestamp(const char *str, struct pg_tm *tm, fsec_t *fsec,
+						 int *tzp)
+{
+	const char *cp = str;
+
+	if (!DecodeFixedDigits(&cp, 4, &tm->tm_year))
+		return false;
+	if (*cp++ != '-' || !DecodeFixedDigits(&cp, 2, &tm->tm_mon))
+		return false;
+	if (*cp++ != '-' || !DecodeFixedDigits(&cp, 2, &tm->tm_mday))
+		return false;
+	if (*cp != ' ' && *cp != 'T')
+		return false;
+	cp++;
+	if (!DecodeFixedDigits(&cp, 2, &tm->tm_hour))
+		return false;
+	if (*cp++ != ':' || !DecodeFixedDigits(&cp, 2, &tm->tm_min))
+		return false;
+	if (*cp++ != ':' || !DecodeFixedDigits(&cp, 2, &tm->tm_sec))
+		return false;
+
+	if (tm->tm_year == 0 ||
+		tm->tm_mon < 1 || tm->tm_mon > MONTHS_PER_YEAR ||
+		tm->tm_mday < 1 ||
+		tm->tm_mday > day_tab[isleap(tm->tm_year)][tm->tm_mon - 1] ||
+		tm->tm_hour >= HOURS_PER_DAY ||
+		tm->tm_min >= MINS_PER_HOUR ||
+		tm->tm_sec >= SECS_PER_MINUTE)
+		return false;
+
+	*fsec = 0;
+	if (*cp == '.')
+	{
+		int			nfrac = 0;
+		fsec_t		frac = 0;
+
+		cp++;
+		while (*cp >= '0' && *cp <= '9')
+		{
+			if (++nfrac > MAX_TIMESTAMP_PRECISION)
+				return false;
+			frac = frac * 10 + (*cp++ - '0');
+		}
+		if (nfrac == 0)
+			return false;
+		while (nfrac++ < MAX_TIMESTAMP_PRECISION)
+			frac *= 10;
+		*fsec = frac;
+	}
+
+	tm->tm_isdst = -1;
+
+	if (*cp == '\0')
+	{
+		/* no zone field: resolve against the session timezone */
+		if (tzp != NULL)
+			*tzp = DetermineTimeZoneOffset(tm, session_timezone);
+		return true;
+	}
+
+	if (*cp == '+' || *cp == '-')
+	{
+		if (tzp == NULL)
+			return false;
+		/* DecodeTimezone range-checks the offset and rejects trailing junk */
+		if (DecodeTimezone(unconstify(char *, cp), tzp) != 0)
+			return false;
+		return true;
+	}
+
+	return false;
+}
+
+
 /* DecodeDateTime()
  * Interpret previously parsed fields for general date and time.
  * Return 0 if full date, 1 if only time, and negative DTERR code if problems.
@@ -15,6 +15,8 @@
  * MatchText - to name of function wanted
  * do_like_escape - name of function if wanted - needs CHAREQ and CopyAdvChar
  * MATCH_LOWER - define for case (4) to specify case folding for 1-byte chars
+ * USE_MEMCHR_SCAN - define if memchr() on the first pattern byte always
+ * lands on a character boundary of the text (cases (1) and (2))
  *
  * Copyright (c) 1996-2022, PostgreSQL Global Development Group
  *
@@ -171,6 +173,31 @@ MatchText(const char *t, int tlen, const char *p, int plen,
 			else
 				firstpat = GETCHAR(*p);
 
+#ifdef USE_MEMCHR_SCAN
+
+			/*
+			 * Let memchr() find each candidate position in one go, rather
+			 * than inspecting the text a character at a time.  This is
+			 * safe in single-byte encodings, obviously; and in UTF8, too,
+			 * because the first byte of a pattern character is either ASCII
+			 * or a lead byte, neither of which can appear as a non-first
+			 * byte of a text character.
+			 */
+			while (tlen > 0)
+			{
+				const char *t1 = memchr(t, (unsigned char) firstpat, tlen);
+				int			matched;
+
+				if (t1 == NULL)
+					break;
+				tlen -= (t1 - t);
+				t = t1;
+				matched = MatchText(t, tlen, p, plen, locale, locale_is_c);
+				if (matched != LIKE_FALSE)
+					return matched; /* TRUE or ABORT */
+				NextChar(t, tlen);
+			}
+#else							/* !USE_MEMCHR_SCAN */
 			while (tlen > 0)
 			{
 				if (GETCHAR(*t) == firstpat)
@@ -184,6 +211,7 @@ MatchText(const char *t, int tlen, const char *p, int plen,
 
 				NextChar(t, tlen);
 			}
+#endif							/* USE_MEMCHR_SCAN */
 
 			/*
 			 * End of text with no match, so no point in trying later places
@@ -358,3 +386,7 @@ do_like_escape(text *pat, text *esc)
 #undef MATCH_LOWER
 
 #endif
+
+#ifdef USE_MEMCHR_SCAN
+#undef USE_MEMCHR_SCAN
+#endif
@@ -100,6 +100,7 @@
 #include "access/brin.h"
 #include "access/brin_page.h"
 #include "access/gin.h"
+#include "access/nbtree.h"
 #include "access/table.h"
 #include "access/tableam.h"
 #include "access/visibilitymap.h"
@@ -146,14 +147,14 @@ get_relation_stats_hook_type get_relation_stats_hook = NULL;
 get_index_stats_hook_type get_index_stats_hook = NULL;
 
 static double eqsel_internal(PG_FUNCTION_ARGS, bool negate);
-static double eqjoinsel_inner(Oid opfuncoid, Oid collation,
+static double eqjoinsel_inner(Oid operator, Oid opfuncoid, Oid collation,
 							  VariableStatData *vardata1, VariableStatData *vardata2,
 							  double nd1, double nd2,
 							  bool isdefault1, bool isdefault2,
 							  AttStatsSlot *sslot1, AttStatsSlot *sslot2,
 							  Form_pg_statistic stats1, Form_pg_statistic stats2,
 							  bool have_mcvs1, bool have_mcvs2);
-static double eqjoinsel_semi(Oid opfuncoid, Oid collation,
+static double eqjoinsel_semi(Oid operator, Oid opfuncoid, Oid collation,
 							 VariableStatData *vardata1, VariableStatData *vardata2,
 							 double nd1, double nd2,
 							 bool isdefault1, bool isdefault2,
@@ -161,6 +162,12 @@ static double eqjoinsel_semi(Oid opfuncoid, Oid collation,
 							 Form_pg_statistic stats1, Form_pg_statistic stats2,
 							 bool have_mcvs1, bool have_mcvs2,
 							 RelOptInfo *inner_rel);
+static bool eqjoinsel_merge_mcvs(Oid operator, Oid collation,
+								 AttStatsSlot *sslot1, int nvalues1,
+								 AttStatsSlot *sslot2, int nvalues2,
+								 bool *hasmatch1, bool *hasmatch2,
+								 double *matchprodfreq, int *nmatches);
+static int	mcv_sort_cmp(const void *a, const void *b, void *arg);
 static bool estimate_multivariate_ndistinct(PlannerInfo *root,
 											RelOptInfo *rel, List **varinfos, double *ndistinct);
 static bool convert_to_scalar(Datum value, Oid valuetypid, Oid collid,
@@ -2296,7 +2303,7 @@ eqjoinsel(PG_FUNCTION_ARGS)
 	}
 
 	/* We need to compute the inner-join selectivity in all cases */
-	selec_inner = eqjoinsel_inner(opfuncoid, collation,
+	selec_inner = eqjoinsel_inner(operator, opfuncoid, collation,
 								  &vardata1, &vardata2,
 								  nd1, nd2,
 								  isdefault1, isdefault2,
@@ -2323,7 +2330,7 @@ eqjoinsel(PG_FUNCTION_ARGS)
 			inner_rel = find_join_input_rel(root, sjinfo->min_righthand);
 
 			if (!join_is_reversed)
-				selec = eqjoinsel_semi(opfuncoid, collation,
+				selec = eqjoinsel_semi(operator, opfuncoid, collation,
 									   &vardata1, &vardata2,
 									   nd1, nd2,
 									   isdefault1, isdefault2,
@@ -2336,7 +2343,7 @@ eqjoinsel(PG_FUNCTION_ARGS)
 				Oid			commop = get_commutator(operator);
 				Oid			commopfuncoid = OidIsValid(commop) ? get_opcode(commop) : InvalidOid;
 
-				selec = eqjoinsel_semi(commopfuncoid, collation,
+				selec = eqjoinsel_semi(commop, commopfuncoid, collation,
 									   &vardata2, &vardata1,
 									   nd2, nd1,
 									   isdefault2, isdefault1,
@@ -2377,6 +2384,148 @@ eqjoinsel(PG_FUNCTION_ARGS)
 	PG_RETURN_FLOAT8((float8) selec);
 }
 
+/*
+ * Sort comparator for eqjoinsel_merge_mcvs: compares MCV list indexes
+ * according to the datums they denote.
+ */
+typedef struct
+{
+	FmgrInfo   *cmpproc;
+	Oid			collation;
+	Datum	   *values;
+} McvSortContext;
+
+static int
+mcv_sort_cmp(const void *a, const void *b, void *arg)
+{
+	McvSortContext *cxt = (McvSortContext *) arg;
+	int			ia = *(const int *) a;
+	int			ib = *(const int *) b;
+
+	return DatumGetInt32(FunctionCall2Coll(cxt->cmpproc, cxt->collation,
+										   cxt->values[ia],
+										   cxt->values[ib]));
+}
+
+/*
+ * eqjoinsel_merge_mcvs --- sort/merge implementation of MCV matching
+ *
+ * Identify which members of two MCV lists join to each other, by sorting
+ * both lists and merging them rather than comparing every pair.  Only the
+ * first nvalues1/nvalues2 members of each list are considered.  On success,
+ * sets the corresponding hasmatch1[]/hasmatch2[] flags (the caller must
+ * have zeroed the arrays), adds each match's product of frequencies to
+ * *matchprodfreq (unless that's NULL), counts matches into *nmatches, and
+ * returns true.
+ *
+ * This needs btree ordering support consistent with the given equality
+ * operator; if there is none, return false without side effects and let
+ * the caller match the lists pairwise.  The comparison procs are taken
+ * from an opfamily in which "operator" is the equality member, so
+ * compares-equal agrees with the operator per the opfamily consistency
+ * requirements that merge join also depends on.  Cross-type operators
+ * work because btree opfamilies supply cross-type comparison procs.
+ */
+static bool
+eqjoinsel_merge_mcvs(Oid operator, Oid collation,
+					 AttStatsSlot *sslot1, int nvalues1,
+					 AttStatsSlot *sslot2, int nvalues2,
+					 bool *hasmatch1, bool *hasmatch2,
+					 double *matchprodfreq, int *nmatches)
+{
+	List	   *opfamilies;
+	Oid			opfamily;
+	Oid			ltype,
+				rtype;
+	Oid			cmpproc1,
+				cmpproc2,
+				crossproc;
+	FmgrInfo	cmp1,
+				cmp2,
+				crosscmp;
+	McvSortContext cxt;
+	int		   *idx1,
+			   *idx2;
+	int			i,
+				j;
+
+	if (!OidIsValid(operator))
+		return false;
+
+	opfamilies = get_mergejoin_opfamilies(operator);
+	if (opfamilies == NIL)
+		return false;
+	opfamily = linitial_oid(opfamilies);
+	list_free(opfamilies);
+
+	op_input_types(operator, &ltype, &rtype);
+	cmpproc1 = get_opfamily_proc(opfamily, ltype, ltype, BTORDER_PROC);
+	cmpproc2 = get_opfamily_proc(opfamily, rtype, rtype, BTORDER_PROC);
+	crossproc = get_opfamily_proc(opfamily, ltype, rtype, BTORDER_PROC);
+	if (!OidIsValid(cmpproc1) || !OidIsValid(cmpproc2) ||
+		!OidIsValid(crossproc))
+		return false;
+
+	fmgr_info(cmpproc1, &cmp1);
+	fmgr_info(cmpproc2, &cmp2);
+	fmgr_info(crossproc, &crosscmp);
+
+	/*
+	 * Sort arrays of list indexes rather than the values themselves, so
+	 * that the values[]/numbers[] pairing is preserved.
+	 */
+	idx1 = (int *) palloc(nvalues1 * sizeof(int));
+	for (i = 0; i < nvalues1; i++)
+		idx1[i] = i;
+	cxt.cmpproc = &cmp1;
+	cxt.collation = collation;
+	cxt.values = sslot1->values;
+	qsort_arg(idx1, nvalues1, sizeof(int), mcv_sort_cmp, &cxt);
+
+	idx2 = (int *) palloc(nvalues2 * sizeof(int));
+	for (i = 0; i < nvalues2; i++)
+		idx2[i] = i;
+	cxt.cmpproc = &cmp2;
+	cxt.values = sslot2->values;
+	qsort_arg(idx2, nvalues2, sizeof(int), mcv_sort_cmp, &cxt);
+
+	/*
+	 * Merge.  The members of each list are distinct, so every value can
+	 * match at most one member of the other list, just as the pairwise
+	 * strategy assumes.
+	 */
+	i = j = 0;
+	while (i < nvalues1 && j < nvalues2)
+	{
+		int32		cmp;
+
+		cmp = DatumGetInt32(FunctionCall2Coll(&crosscmp, collation,
+											  sslot1->values[idx1[i]],
+											  sslot2->values[idx2[j]]));
+		if (cmp < 0)
+			i++;
+		else if (cmp > 0)
+			j++;
+		else
+		{
+			int			i1 = idx1[i];
+			int			i2 = idx2[j];
+
+			hasmatch1[i1] = hasmatch2[i2] = true;
+			if (matchprodfreq)
+				*matchprodfreq += sslot1->numbers[i1] * sslot2->numbers[i2];
+			(*nmatches)++;
+			i++;
+			j++;
+		}
+	}
+
+	pfree(idx1);
+	pfree(idx2);
+
+	return true;
+}
+
 /*
  * eqjoinsel_inner --- eqjoinsel for normal inner join
  *
@@ -2384,7 +2533,7 @@ eqjoinsel(PG_FUNCTION_ARGS)
  * that it's worth trying to distinguish them here.
  */
 static double
-eqjoinsel_inner(Oid opfuncoid, Oid collation,
+eqjoinsel_inner(Oid operator, Oid opfuncoid, Oid collation,
 				VariableStatData *vardata1, VariableStatData *vardata2,
 				double nd1, double nd2,
 				bool isdefault1, bool isdefault2,
@@ -2426,51 +2575,66 @@ eqjoinsel_inner(Oid opfuncoid, Oid collation,
 		int			i,
 					nmatches;
 
-		fmgr_info(opfuncoid, &eqproc);
-
-		/*
-		 * Save a few cycles by setting up the fcinfo struct just once. Using
-		 * FunctionCallInvoke directly also avoids failure if the eqproc
-		 * returns NULL, though really equality functions should never do
-		 * that.
-		 */
-		InitFunctionCallInfoData(*fcinfo, &eqproc, 2, collation,
-								 NULL, NULL);
-		fcinfo->args[0].isnull = false;
-		fcinfo->args[1].isnull = false;
-
 		hasmatch1 = (bool *) palloc0(sslot1->nvalues * sizeof(bool));
 		hasmatch2 = (bool *) palloc0(sslot2->nvalues * sizeof(bool));
 
-		/*
-		 * Note we assume that each MCV will match at most one member of the
-		 * other MCV list.  If the operator isn't really equality, there could
-		 * be multiple matches --- but we don't look for them, both for speed
-		 * and because the math wouldn't add up...
-		 */
 		matchprodfreq = 0.0;
 		nmatches = 0;
-		for (i = 0; i < sslot1->nvalues; i++)
+
+		/*
+		 * Matching the lists pairwise is quadratic in their lengths, which
+		 * hurts with large statistics targets; when the pair count is big
+		 * enough for the setup cost to pay off, try to sort and merge the
+		 * lists instead.
+		 */
+		if ((double) sslot1->nvalues * (double) sslot2->nvalues < 10000.0 ||
+			!eqjoinsel_merge_mcvs(operator, collation,
+								  sslot1, sslot1->nvalues,
+								  sslot2, sslot2->nvalues,
+								  hasmatch1, hasmatch2,
+								  &matchprodfreq, &nmatches))
 		{
-			int			j;
+			fmgr_info(opfuncoid, &eqproc);
 
-			fcinfo->args[0].value = sslot1->values[i];
+			/*
+			 * Save a few cycles by setting up the fcinfo struct just once.
+			 * Using FunctionCallInvoke directly also avoids failure if the
+			 * eqproc returns NULL, though really equality functions should
+			 * never do that.
+			 */
+			InitFunctionCallInfoData(*fcinfo, &eqproc, 2, collation,
+									 NULL, NULL);
+			fcinfo->args[0].isnull = false;
+			fcinfo->args[1].isnull = false;
 
-			for (j = 0; j < sslot2->nvalues; j++)
+			/*
+			 * Note we assume that each MCV will match at most one member of
+			 * the other MCV list.  If the operator isn't really equality,
+			 * there could be multiple matches --- but we don't look for
+			 * them, both for speed and because the math wouldn't add up...
+			 */
+			for (i = 0; i < sslot1->nvalues; i++)
 			{
-				Datum		fresult;
+				int			j;
 
-				if (hasmatch2[j])
-					continue;
-				fcinfo->args[1].value = sslot2->values[j];
-				fcinfo->isnull = false;
-				fresult = FunctionCallInvoke(fcinfo);
-				if (!fcinfo->isnull && DatumGetBool(fresult))
+				fcinfo->args[0].value = sslot1->values[i];
+
+				for (j = 0; j < sslot2->nvalues; j++)
 				{
-					hasmatch1[i] = hasmatch2[j] = true;
-					matchprodfreq += sslot1->numbers[i] * sslot2->numbers[j];
-					nmatches++;
-					break;
+					Datum		fresult;
+
+					if (hasmatch2[j])
+						continue;
+					fcinfo->args[1].value = sslot2->values[j];
+					fcinfo->isnull = false;
+					fresult = FunctionCallInvoke(fcinfo);
+					if (!fcinfo->isnull && DatumGetBool(fresult))
+					{
+						hasmatch1[i] = hasmatch2[j] = true;
+						matchprodfreq += sslot1->numbers[i] * sslot2->numbers[j];
+						nmatches++;
+						break;
+					}
 				}
 			}
 		}
@@ -2581,7 +2745,7 @@ eqjoinsel_inner(Oid opfuncoid, Oid collation,
  * Unlike eqjoinsel_inner, we have to cope with opfuncoid being InvalidOid.
  */
 static double
-eqjoinsel_semi(Oid opfuncoid, Oid collation,
+eqjoinsel_semi(Oid operator, Oid opfuncoid, Oid collation,
 			   VariableStatData *vardata1, VariableStatData *vardata2,
 			   double nd1, double nd2,
 			   bool isdefault1, bool isdefault2,
@@ -2656,49 +2820,63 @@ eqjoinsel_semi(Oid opfuncoid, Oid collation,
 		 */
 		clamped_nvalues2 = Min(sslot2->nvalues, nd2);
 
-		fmgr_info(opfuncoid, &eqproc);
-
-		/*
-		 * Save a few cycles by setting up the fcinfo struct just once. Using
-		 * FunctionCallInvoke directly also avoids failure if the eqproc
-		 * returns NULL, though really equality functions should never do
-		 * that.
-		 */
-		InitFunctionCallInfoData(*fcinfo, &eqproc, 2, collation,
-								 NULL, NULL);
-		fcinfo->args[0].isnull = false;
-		fcinfo->args[1].isnull = false;
-
 		hasmatch1 = (bool *) palloc0(sslot1->nvalues * sizeof(bool));
 		hasmatch2 = (bool *) palloc0(clamped_nvalues2 * sizeof(bool));
 
+		nmatches = 0;
+
 		/*
-		 * Note we assume that each MCV will match at most one member of the
-		 * other MCV list.  If the operator isn't really equality, there could
-		 * be multiple matches --- but we don't look for them, both for speed
-		 * and because the math wouldn't add up...
+		 * As in eqjoinsel_inner, prefer sorting and merging the lists over
+		 * the quadratic pairwise comparison once the pair count makes the
+		 * setup cost worthwhile.
 		 */
-		nmatches = 0;
-		for (i = 0; i < sslot1->nvalues; i++)
+		if ((double) sslot1->nvalues * (double) clamped_nvalues2 < 10000.0 ||
+			!eqjoinsel_merge_mcvs(operator, collation,
+								  sslot1, sslot1->nvalues,
+								  sslot2, clamped_nvalues2,
+								  hasmatch1, hasmatch2,
+								  NULL, &nmatches))
 		{
-			int			j;
+			fmgr_info(opfuncoid, &eqproc);
 
-			fcinfo->args[0].value = sslot1->values[i];
+			/*
+			 * Save a few cycles by setting up the fcinfo struct just once.
+			 * Using FunctionCallInvoke directly also avoids failure if the
+			 * eqproc returns NULL, though really equality functions should
+			 * never do that.
+			 */
+			InitFunctionCallInfoData(*fcinfo, &eqproc, 2, collation,
+									 NULL, NULL);
+			fcinfo->args[0].isnull = false;
+			fcinfo->args[1].isnull = false;
 
-			for (j = 0; j < clamped_nvalues2; j++)
+			/*
+			 * Note we assume that each MCV will match at most one member of
+			 * the other MCV list.  If the operator isn't really equality,
+			 * there could be multiple matches --- but we don't look for
+			 * them, both for speed and because the math wouldn't add up...
+			 */
+			for (i = 0; i < sslot1->nvalues; i++)
 			{
-				Datum		fresult;
+				int			j;
 
-				if (hasmatch2[j])
-					continue;
-				fcinfo->args[1].value = sslot2->values[j];
-				fcinfo->isnull = false;
-				fresult = FunctionCallInvoke(fcinfo);
-				if (!fcinfo->isnull && DatumGetBool(fresult))
+				fcinfo->args[0].value = sslot1->values[i];
+
+				for (j = 0; j < clamped_nvalues2; j++)
 				{
-					hasmatch1[i] = hasmatch2[j] = true;
-					nmatches++;
-					break;
+					Datum		fresult;
+
+					if (hasmatch2[j])
+						continue;
+					fcinfo->args[1].value = sslot2->values[j];
+					fcinfo->isnull = false;
+					fresult = FunctionCallInvoke(fcinfo);
+					if (!fcinfo->isnull && DatumGetBool(fresult))
+					{
+						hasmatch1[i] = hasmatch2[j] = true;
+						nmatches++;
+						break;
+					}
 				}
 			}
 		}
@@ -3138,6 +3138,48 @@ get_attavgwidth(Oid relid, AttrNumber attnum)
 	return 0;
 }
 
+/*
+ * get_rel_attavgwidths
+ *
+ *	  Fetch the average widths of all columns of a table in one batched
+ *	  pg_statistic lookup, filling widths[1..natts].  Entries for columns
+ *	  with no data available are set to zero, as in get_attavgwidth.
+ *
+ * This is cheaper than probing get_attavgwidth once per column when most
+ * of the relation's statistics are not yet in the syscache, since it
+ * fetches all of the relation's pg_statistic rows with a single scan.
+ * The side effect of loading those rows into the syscache also benefits
+ * later per-column lookups.  Like get_attavgwidth, this ignores
+ * inheritance statistics.
+ *
+ * Note: callers must check get_attavgwidth_hook themselves; this function
+ * does not consult it.
+ */
+void
+get_rel_attavgwidths(Oid relid, int natts, int32 *widths)
+{
+	CatCList   *statlist;
+	int			i;
+
+	for (i = 1; i <= natts; i++)
+		widths[i] = 0;
+
+	statlist = SearchSysCacheList1(STATRELATTINH, ObjectIdGetDatum(relid));
+
+	for (i = 0; i < statlist->n_members; i++)
+	{
+		HeapTuple	tp = &statlist->members[i]->tuple;
+		Form_pg_statistic stats = (Form_pg_statistic) GETSTRUCT(tp);
+
+		if (!stats->stainherit &&
+			stats->staattnum >= 1 && stats->staattnum <= natts &&
+			stats->stawidth > 0)
+			widths[stats->staattnum] = stats->stawidth;
+	}
+
+	ReleaseSysCacheList(statlist);
+}
+
 /*
  * get_attstatsslot
  *
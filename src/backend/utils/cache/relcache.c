@@ -523,20 +523,16 @@ RelationBuildTupleDesc(Relation relation)
 	SysScanDesc pg_attribute_scan;
 	ScanKeyData skey[2];
 	int			need;
-	TupleConstr *constr;
 	AttrMissing *attrmiss = NULL;
 	int			ndef = 0;
+	bool		has_not_null = false;
+	bool		has_generated_stored = false;
 
 	/* fill rd_att's type ID fields (compare heap.c's AddNewRelationTuple) */
 	relation->rd_att->tdtypeid =
 		relation->rd_rel->reltype ? relation->rd_rel->reltype : RECORDOID;
 	relation->rd_att->tdtypmod = -1;	/* just to be sure */
 
-	constr = (TupleConstr *) MemoryContextAllocZero(CacheMemoryContext,
-													sizeof(TupleConstr));
-	constr->has_not_null = false;
-	constr->has_generated_stored = false;
-
 	/*
 	 * Form a scan key that selects only user attributes (attnum > 0).
 	 * (Eliminating system attribute rows at the index level is lots faster
@@ -586,9 +582,9 @@ RelationBuildTupleDesc(Relation relation)
 
 		/* Update constraint/default info */
 		if (attp->attnotnull)
-			constr->has_not_null = true;
+			has_not_null = true;
 		if (attp->attgenerated == ATTRIBUTE_GENERATED_STORED)
-			constr->has_generated_stored = true;
+			has_generated_stored = true;
 		if (attp->atthasdef)
 			ndef++;
 
@@ -681,14 +677,23 @@ RelationBuildTupleDesc(Relation relation)
 		TupleDescAttr(relation->rd_att, 0)->attcacheoff = 0;
 
 	/*
-	 * Set up constraint/default info
+	 * Set up constraint/default info.  The TupleConstr struct is allocated
+	 * only if we found anything that needs it; for the common plain-table
+	 * case this saves an alloc/free cycle in CacheMemoryContext for every
+	 * relcache entry built.
 	 */
-	if (constr->has_not_null ||
-		constr->has_generated_stored ||
+	if (has_not_null ||
+		has_generated_stored ||
 		ndef > 0 ||
 		attrmiss ||
 		relation->rd_rel->relchecks > 0)
 	{
+		TupleConstr *constr;
+
+		constr = (TupleConstr *) MemoryContextAllocZero(CacheMemoryContext,
+														sizeof(TupleConstr));
+		constr->has_not_null = has_not_null;
+		constr->has_generated_stored = has_generated_stored;
 		relation->rd_att->constr = constr;
 
 		if (ndef > 0)			/* DEFAULTs */
@@ -704,10 +709,7 @@ RelationBuildTupleDesc(Relation relation)
 			constr->num_check = 0;
 	}
 	else
-	{
-		pfree(constr);
 		relation->rd_att->constr = NULL;
-	}
 }
 
 /*
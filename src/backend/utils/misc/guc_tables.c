@@ -63,6 +63,7 @@
 #include "replication/syncrep.h"
 #include "storage/bufmgr.h"
 #include "storage/large_object.h"
+#include "storage/md.h"
 #include "storage/pg_shmem.h"
 #include "storage/predicate.h"
 #include "storage/standby.h"
@@ -1085,6 +1086,33 @@ struct config_bool ConfigureNamesBool[] =
 		false,
 		NULL, NULL, NULL
 	},
+	{
+		{"numa_buffers_interleave", PGC_POSTMASTER, RESOURCES_MEM,
+			gettext_noop("Interleaves shared buffer pages across NUMA nodes."),
+			gettext_noop("On NUMA systems this spreads the buffer pool evenly "
+						 "over all memory nodes rather than leaving placement "
+						 "to the kernel's first-touch policy. Only has an "
+						 "effect if the server was built with NUMA support.")
+		},
+		&numa_buffers_interleave,
+		false,
+		NULL, NULL, NULL
+	},
+	{
+		{"io_direct_data", PGC_POSTMASTER, DEVELOPER_OPTIONS,
+			gettext_noop("Uses direct I/O for relation data files."),
+			gettext_noop("Opens relation data files with O_DIRECT (where "
+						 "available) so that reads and writes bypass the "
+						 "operating system page cache, avoiding "
+						 "double-buffering with shared_buffers. Currently "
+						 "intended for testing and for installations that "
+						 "size shared_buffers to most of RAM."),
+			GUC_NOT_IN_SAMPLE
+		},
+		&io_direct_data,
+		false,
+		NULL, NULL, NULL
+	},
 	{
 		{"ignore_invalid_pages", PGC_POSTMASTER, DEVELOPER_OPTIONS,
 			gettext_noop("Continues recovery after an invalid pages failure."),
@@ -2682,6 +2710,21 @@ struct config_int ConfigureNamesInt[] =
 		check_wal_buffers, NULL, NULL
 	},
 
+	{
+		{"wal_insert_locks", PGC_POSTMASTER, WAL_SETTINGS,
+			gettext_noop("Sets the number of WAL insertion locks."),
+			gettext_noop("-1 scales the number of locks with max_connections.")
+		},
+		&NumXLogInsertLocks,
+		/*
+		 * The maximum must stay comfortably below MAX_SIMUL_LWLOCKS
+		 * (lwlock.c), since WALInsertLockAcquireExclusive() takes all the
+		 * insertion locks at once.
+		 */
+		-1, -1, 128,
+		check_wal_insert_locks, NULL, NULL
+	},
+
 	{
 		{"wal_writer_delay", PGC_SIGHUP, WAL_SETTINGS,
 			gettext_noop("Time between WAL flushes performed in the WAL writer."),
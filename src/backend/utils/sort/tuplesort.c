@@ -513,7 +513,7 @@ qsort_tuple_unsigned_compare(SortTuple *a, SortTuple *b, Tuplesortstate *state)
 	if (state->base.onlyKey != NULL)
 		return 0;
 
-	return state->base.comparetup(a, b, state);
+	return state->base.comparetup_tiebreak(a, b, state);
 }
 
 #if SIZEOF_DATUM >= 8
@@ -537,7 +537,7 @@ qsort_tuple_signed_compare(SortTuple *a, SortTuple *b, Tuplesortstate *state)
 	if (state->base.onlyKey != NULL)
 		return 0;
 
-	return state->base.comparetup(a, b, state);
+	return state->base.comparetup_tiebreak(a, b, state);
 }
 #endif
 
@@ -561,7 +561,7 @@ qsort_tuple_int32_compare(SortTuple *a, SortTuple *b, Tuplesortstate *state)
 	if (state->base.onlyKey != NULL)
 		return 0;
 
-	return state->base.comparetup(a, b, state);
+	return state->base.comparetup_tiebreak(a, b, state);
 }
 
 /*
@@ -623,6 +623,62 @@ qsort_tuple_int32_compare(SortTuple *a, SortTuple *b, Tuplesortstate *state)
 #define ST_DEFINE
 #include "lib/sort_template.h"
 
+/*
+ * Compare two SortTuples in the sift-up/sift-down paths of the merge heap.
+ *
+ * Where the sort keeps the leading key's value in datum1, compare that
+ * inline and only make the indirect call for genuine ties, mirroring what
+ * the qsort specializations above do for the run-formation phase.  The
+ * merge phase of an external sort spends nearly all of its time in these
+ * comparisons, so saving the function call and the repeated leading-key
+ * comparison inside comparetup is worthwhile.
+ */
+static pg_attribute_always_inline int
+tuplesort_compare(Tuplesortstate *state, const SortTuple *a, const SortTuple *b)
+{
+	if (state->base.sortKeys != NULL && state->base.haveDatum1)
+	{
+		SortSupport ssup = state->base.sortKeys;
+		int			compare;
+
+		/*
+		 * Recognize the comparators that tuplesort_sort_memtuples has
+		 * specialized sorts for, and apply them inline here too rather than
+		 * jumping through the comparator pointer.  These branches all test a
+		 * value that is constant for the duration of the sort, so they
+		 * predict perfectly.
+		 */
+		if (ssup->comparator == ssup_datum_unsigned_cmp)
+			compare = ApplyUnsignedSortComparator(a->datum1, a->isnull1,
+												  b->datum1, b->isnull1,
+												  ssup);
+#if SIZEOF_DATUM >= 8
+		else if (ssup->comparator == ssup_datum_signed_cmp)
+			compare = ApplySignedSortComparator(a->datum1, a->isnull1,
+												b->datum1, b->isnull1,
+												ssup);
+#endif
+		else if (ssup->comparator == ssup_datum_int32_cmp)
+			compare = ApplyInt32SortComparator(a->datum1, a->isnull1,
+											   b->datum1, b->isnull1,
+											   ssup);
+		else
+			compare = ApplySortComparator(a->datum1, a->isnull1,
+										  b->datum1, b->isnull1,
+										  ssup);
+		if (compare != 0)
+			return compare;
+
+		/* with a single, unabbreviated key a datum1 tie is a real tie */
+		if (state->base.onlyKey != NULL)
+			return 0;
+
+		return state->base.comparetup_tiebreak(a, b, state);
+	}
+
+	return COMPARETUP(state, a, b);
+}
+
 /*
  *		tuplesort_begin_xxx
  *
@@ -1303,7 +1359,7 @@ tuplesort_puttuple_common(Tuplesortstate *state, SortTuple *tuple, bool useAbbre
 			 * with just this one comparison.  Note that because we currently
 			 * have the sort direction reversed, we must check for <= not >=.
 			 */
-			if (COMPARETUP(state, tuple, &state->memtuples[0]) <= 0)
+			if (tuplesort_compare(state, tuple, &state->memtuples[0]) <= 0)
 			{
 				/* new tuple <= top of the heap, so we can discard it */
 				free_sort_tuple(state, tuple);
@@ -2653,7 +2709,7 @@ make_bounded_heap(Tuplesortstate *state)
 			 * tuple, or just discard it, if it's larger than anything already
 			 * in the heap.
 			 */
-			if (COMPARETUP(state, &state->memtuples[i], &state->memtuples[0]) <= 0)
+			if (tuplesort_compare(state, &state->memtuples[i], &state->memtuples[0]) <= 0)
 			{
 				free_sort_tuple(state, &state->memtuples[i]);
 				CHECK_FOR_INTERRUPTS();
@@ -2793,7 +2849,7 @@ tuplesort_heap_insert(Tuplesortstate *state, SortTuple *tuple)
 	{
 		int			i = (j - 1) >> 1;
 
-		if (COMPARETUP(state, tuple, &memtuples[i]) >= 0)
+		if (tuplesort_compare(state, tuple, &memtuples[i]) >= 0)
 			break;
 		memtuples[j] = memtuples[i];
 		j = i;
@@ -2857,9 +2913,9 @@ tuplesort_heap_replace_top(Tuplesortstate *state, SortTuple *tuple)
 		if (j >= n)
 			break;
 		if (j + 1 < n &&
-			COMPARETUP(state, &memtuples[j], &memtuples[j + 1]) > 0)
+			tuplesort_compare(state, &memtuples[j], &memtuples[j + 1]) > 0)
 			j++;
-		if (COMPARETUP(state, tuple, &memtuples[j]) <= 0)
+		if (tuplesort_compare(state, tuple, &memtuples[j]) <= 0)
 			break;
 		memtuples[i] = memtuples[j];
 		i = j;
@@ -2323,19 +2323,43 @@ XidInMVCCSnapshot(TransactionId xid, Snapshot snapshot)
 		}
 		else
 		{
+			TransactionId topxid;
+
 			/*
-			 * Snapshot overflowed, so convert xid to top-level.  This is safe
-			 * because we eliminated too-old XIDs above.
+			 * Snapshot overflowed, so we may need pg_subtrans to convert the
+			 * XID to its top-level parent.  That costs an SLRU lookup per
+			 * nesting level, so first search the XIDs the snapshot did manage
+			 * to collect: if the given XID is a still-running top-level XID,
+			 * or one of the subxact XIDs gathered before the snapshot
+			 * overflowed, we can answer without touching pg_subtrans at all.
 			 */
-			xid = SubTransGetTopmostTransaction(xid);
+			if (pg_lfind32(xid, snapshot->xip, snapshot->xcnt))
+				return true;
+			if (pg_lfind32(xid, snapshot->subxip, snapshot->subxcnt))
+				return true;
+
+			/*
+			 * Convert xid to top-level.  This is safe because we eliminated
+			 * too-old XIDs above.
+			 */
+			topxid = SubTransGetTopmostTransaction(xid);
+
+			/*
+			 * If it wasn't a subxact after all, the searches above already
+			 * proved that it isn't in the snapshot.
+			 */
+			if (TransactionIdEquals(topxid, xid))
+				return false;
 
 			/*
 			 * If xid was indeed a subxact, we might now have an xid < xmin,
 			 * so recheck to avoid an array scan.  No point in rechecking
 			 * xmax.
 			 */
-			if (TransactionIdPrecedes(xid, snapshot->xmin))
+			if (TransactionIdPrecedes(topxid, snapshot->xmin))
 				return false;
+
+			xid = topxid;
 		}
 
 		if (pg_lfind32(xid, snapshot->xip, snapshot->xcnt))
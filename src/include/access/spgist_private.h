@@ -193,6 +193,11 @@ typedef struct SpGistScanOpaqueData
 	MemoryContext tempCxt;		/* short-lived memory context */
 	MemoryContext traversalCxt; /* single scan lifetime memory context */
 
+	/* Inner-page prefetching state, see spgAddSearchItemToQueue */
+	Relation	index;			/* index relation being scanned */
+	int			prefetchMaximum;	/* max prefetches in flight, 0 disables */
+	int			prefetchPending;	/* prefetched pages not yet visited */
+
 	/* Control flags showing whether to search nulls and/or non-nulls */
 	bool		searchNulls;	/* scan matches (all) null entries */
 	bool		searchNonNulls; /* scan matches (some) non-null entries */
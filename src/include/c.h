@@ -256,6 +256,21 @@
 
 #endif							/* defined(__MINGW64__) && __GNUC__ == 8 &&
 								 * __GNUC_MINOR__ == 1 */
+/*
+ * pg_prefetch_mem
+ *		Hint the CPU to fetch the cache line containing the given address.
+ *
+ * This is useful in loops that will shortly dereference a pointer the
+ * hardware prefetcher cannot predict, such as hash bucket or linked-list
+ * walks.  It is only a hint; prefetching an invalid or unmapped address is
+ * harmless, and on compilers without prefetch support it expands to nothing.
+ */
+#if defined(__GNUC__)
+#define pg_prefetch_mem(addr)	__builtin_prefetch(addr)
+#else
+#define pg_prefetch_mem(addr)	((void) 0)
+#endif
+
 /*
  * Mark a point as unreachable in a portable fashion.  This should preferably
  * be something that the compiler understands, to aid code generation.
@@ -1118,7 +1133,25 @@ typedef union PGAlignedBlock
 	int64		force_align_i64;
 } PGAlignedBlock;
 
-/* Same, but for an XLOG_BLCKSZ-sized buffer */
+/*
+ * Use this instead of PGAlignedBlock to declare a page buffer that will be
+ * handed to the storage manager for I/O on relation data files.  When
+ * io_direct_data is enabled, direct transfers typically require the memory
+ * to be aligned on PG_IO_ALIGN_SIZE, which is stricter than MAXALIGN; md.c
+ * copies misaligned buffers through an aligned bounce buffer, so using this
+ * type where possible avoids that extra copy.
+ */
+typedef union PGIOAlignedBlock
+{
+#ifdef pg_attribute_aligned
+	pg_attribute_aligned(PG_IO_ALIGN_SIZE)
+#endif
+	char		data[BLCKSZ];
+	double		force_align_d;
+	int64		force_align_i64;
+} PGIOAlignedBlock;
+
+/* Same as PGAlignedBlock, but for an XLOG_BLCKSZ-sized buffer */
 typedef union PGAlignedXLogBlock
 {
 	char		data[XLOG_BLCKSZ];
@@ -109,6 +109,14 @@ typedef struct PartitionPruningData
  * partprunedata		Array of PartitionPruningData pointers for the plan's
  *						partitioned relation(s), one for each partitioning
  *						hierarchy that requires run-time pruning.
+ *
+ * The remaining fields implement a single-entry cache of the most recent
+ * exec-time pruning result, keyed on the values of the "execparamids"
+ * parameters that were current when it was computed.  Plan nodes above a
+ * nestloop are commonly rescanned many times in a row with identical
+ * parameter values (for instance when the outer side is sorted), in which
+ * case we can reuse the previous result instead of re-evaluating the
+ * pruning steps.  "nexecparams" is zero if result caching is disabled.
  */
 typedef struct PartitionPruneState
 {
@@ -117,6 +125,16 @@ typedef struct PartitionPruneState
 	MemoryContext prune_context;
 	bool		do_initial_prune;
 	bool		do_exec_prune;
+	ExprContext *econtext;		/* source of PARAM_EXEC parameter values */
+	MemoryContext cachecontext; /* where cached key datums and result live */
+	int			nexecparams;	/* # of entries in the cache key arrays */
+	int		   *cacheparamids;	/* IDs of the key parameters */
+	int16	   *cachetyplens;	/* their type lengths */
+	bool	   *cachetypbyvals; /* their type pass-by-value flags */
+	Datum	   *cachevalues;	/* key parameter values of cached result */
+	bool	   *cacheisnulls;	/* their nullness */
+	bool		cachevalid;		/* does the cache hold a usable result? */
+	Bitmapset  *cacheresult;	/* the cached set of subplan indexes */
 	int			num_partprunedata;
 	PartitionPruningData *partprunedata[FLEXIBLE_ARRAY_MEMBER];
 } PartitionPruneState;
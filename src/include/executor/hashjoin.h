@@ -14,6 +14,7 @@
 #ifndef HASHJOIN_H
 #define HASHJOIN_H
 
+#include "lib/bloomfilter.h"
 #include "nodes/execnodes.h"
 #include "port/atomics.h"
 #include "storage/barrier.h"
@@ -315,6 +316,14 @@ typedef struct HashJoinTableData
 
 	bool		growEnabled;	/* flag to shut off nbatch increases */
 
+	/*
+	 * Optional Bloom filter over the hash values of all inner tuples, used
+	 * to reject non-matching outer tuples before probing or saving them to
+	 * batch files.  NULL if not being used (parallel hash, or a join small
+	 * enough that the filter isn't worth its memory).
+	 */
+	bloom_filter *bloomFilter;
+
 	double		totalTuples;	/* # tuples obtained from inner plan */
 	double		partialTuples;	/* # tuples obtained from inner plan by me */
 	double		skewTuples;		/* # tuples inserted into skew tuples */
@@ -2155,8 +2155,8 @@ typedef struct MemoizeState
 	TupleTableSlot *tableslot;	/* min tuple slot for existing cache entries */
 	TupleTableSlot *probeslot;	/* virtual slot used for hash lookups */
 	ExprState  *cache_eq_expr;	/* Compare exec params to hash key */
-	ExprState **param_exprs;	/* exprs containing the parameters to this
-								 * node */
+	ProjectionInfo *cache_keys_proj;	/* projection evaluating all cache key
+										 * exprs into probeslot */
 	FmgrInfo   *hashfunctions;	/* lookup data for hash funcs nkeys in size */
 	Oid		   *collations;		/* collation for comparisons nkeys in size */
 	uint64		mem_used;		/* bytes of memory used by cache */
@@ -2388,6 +2388,9 @@ typedef struct AggState
 										 * exists only during first pass */
 	TupleTableSlot *hash_spill_rslot;	/* for reading spill files */
 	TupleTableSlot *hash_spill_wslot;	/* for writing spill files */
+	MinimalTuple hash_batch_readbuf;	/* reusable buffer for reading one
+										 * spilled tuple at a time */
+	uint32		hash_batch_readbuf_size;	/* allocated size of that buffer */
 	List	   *hash_batches;	/* hash batches remaining to be processed */
 	bool		hash_ever_spilled;	/* ever spilled during this execution? */
 	bool		hash_spill_mode;	/* we hit a limit during the current batch
@@ -919,6 +919,14 @@ typedef struct RelOptInfo
 	/* known not unique for these set(s) */
 	List	   *non_unique_for_rels pg_node_attr(read_write_ignore);
 
+	/*
+	 * cache space for has_join_restriction(); see joinrels.c
+	 */
+	/* cached has_join_restriction() result */
+	bool		has_join_restr pg_node_attr(read_write_ignore);
+	/* is has_join_restr valid? */
+	bool		has_join_restr_valid pg_node_attr(read_write_ignore);
+
 	/*
 	 * used by various scans and joins:
 	 */
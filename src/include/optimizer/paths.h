@@ -214,6 +214,10 @@ extern Path *get_cheapest_path_for_pathkeys(List *paths, List *pathkeys,
 											Relids required_outer,
 											CostSelector cost_criterion,
 											bool require_parallel_safe);
+extern void get_cheapest_paths_for_pathkeys(List *paths, List *pathkeys,
+											Relids required_outer,
+											Path **startup_path,
+											Path **total_path);
 extern Path *get_cheapest_fractional_path_for_pathkeys(List *paths,
 													   List *pathkeys,
 													   Relids required_outer,
@@ -227,6 +227,15 @@
  */
 #define PG_CACHE_LINE_SIZE		128
 
+/*
+ * Assumed alignment requirement for direct I/O.  4K corresponds to common
+ * memory page size and direct I/O alignment requirement on current
+ * hardware.  The buffer pool's data pages are aligned on this boundary so
+ * that they qualify for direct transfers when data files are opened with
+ * O_DIRECT (see io_direct_data).
+ */
+#define PG_IO_ALIGN_SIZE		4096
+
 /*
  *------------------------------------------------------------------------
  * The following symbols are for enabling debugging code, not for
@@ -66,6 +66,7 @@ extern PGDLLIMPORT int NBuffers;
 
 /* in bufmgr.c */
 extern PGDLLIMPORT bool zero_damaged_pages;
+extern PGDLLIMPORT bool numa_buffers_interleave;
 extern PGDLLIMPORT int bgwriter_lru_maxpages;
 extern PGDLLIMPORT double bgwriter_lru_multiplier;
 extern PGDLLIMPORT bool track_io_timing;
@@ -77,12 +77,22 @@ struct XidCache
 #define		PROC_XMIN_FLAGS (PROC_IN_VACUUM | PROC_IN_SAFE_IC)
 
 /*
- * We allow a small number of "weak" relation locks (AccessShareLock,
+ * We allow a limited number of "weak" relation locks (AccessShareLock,
  * RowShareLock, RowExclusiveLock) to be recorded in the PGPROC structure
  * rather than the main lock table.  This eases contention on the lock
  * manager LWLocks.  See storage/lmgr/README for additional details.
+ *
+ * The slots are organized as groups of FP_LOCK_SLOTS_PER_GROUP slots, with
+ * each relation mapped to exactly one group by its OID.  This bounds the
+ * number of slots examined for any particular relation while allowing a
+ * larger total capacity, which matters for queries touching many
+ * partitions.  FP_LOCK_SLOTS_PER_GROUP is sized so that one group's lock
+ * mode bits fit into a single uint64.
  */
-#define		FP_LOCK_SLOTS_PER_BACKEND 16
+#define		FP_LOCK_GROUPS_PER_BACKEND	4
+#define		FP_LOCK_SLOTS_PER_GROUP		16	/* don't change */
+#define		FP_LOCK_SLOTS_PER_BACKEND \
+	(FP_LOCK_SLOTS_PER_GROUP * FP_LOCK_GROUPS_PER_BACKEND)
 
 /*
  * An invalid pgprocno.  Must be larger than the maximum number of PGPROC
@@ -282,9 +292,18 @@ struct PGPROC
 	XLogRecPtr	clogGroupMemberLsn; /* WAL location of commit record for clog
 									 * group member */
 
+	/* Support for group WAL insert-position reservation. */
+	bool		walReserveMember;	/* true, if member of reservation group */
+	pg_atomic_uint32 walReserveNext;	/* next reservation group member */
+	int			walReserveSize; /* usable bytes to reserve (MAXALIGNed) */
+	uint64		walReserveStart;	/* assigned start byte position */
+	uint64		walReserveEnd;	/* assigned end byte position */
+	uint64		walReservePrev; /* byte position of previous record */
+
 	/* Lock manager data, recording fast-path locks taken by this backend. */
 	LWLock		fpInfoLock;		/* protects per-backend fast-path state */
-	uint64		fpLockBits;		/* lock modes held for each fast-path slot */
+	uint64		fpLockBits[FP_LOCK_GROUPS_PER_BACKEND]; /* lock modes held for
+														 * each fast-path slot */
 	Oid			fpRelId[FP_LOCK_SLOTS_PER_BACKEND]; /* slots for rel oids */
 	bool		fpVXIDLock;		/* are we holding a fast-path VXID lock? */
 	LocalTransactionId fpLocalTransactionId;	/* lxid for fast-path VXID
@@ -392,6 +411,8 @@ typedef struct PROC_HDR
 	pg_atomic_uint32 procArrayGroupFirst;
 	/* First pgproc waiting for group transaction status update */
 	pg_atomic_uint32 clogGroupFirst;
+	/* First pgproc waiting for group WAL insert-position reservation */
+	pg_atomic_uint32 walReserveFirst;
 	/* WALWriter process's latch */
 	Latch	   *walwriterLatch;
 	/* Checkpointer process's latch */
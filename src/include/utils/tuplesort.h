@@ -162,6 +162,13 @@ typedef struct
 	 */
 	SortTupleComparator comparetup;
 
+	/*
+	 * Fall back to the full tuple for comparison.  This is the tail of
+	 * comparetup, for use when the leading sort key has already been found
+	 * equal by some cheaper means, e.g. an inlined datum1 comparison.
+	 */
+	SortTupleComparator comparetup_tiebreak;
+
 	/*
 	 * Alter datum1 representation in the SortTuple's array back from the
 	 * abbreviated key to the first column value.